@@ -0,0 +1,132 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorGrid.h"
+
+#include "Logging/Logging.h"
+#include "Scriptable/Actor.h"
+
+namespace GemRB {
+
+void ActorGrid::Reset(const Size& mapSize)
+{
+	gridSize.w = std::max(1, (mapSize.w + BucketCells - 1) / BucketCells);
+	gridSize.h = std::max(1, (mapSize.h + BucketCells - 1) / BucketCells);
+	buckets.clear();
+	buckets.resize(gridSize.Area());
+	slots.clear();
+	maxCircleSize = 0;
+}
+
+// actors outside the map end up in the edge buckets, queries are clamped the same way
+int ActorGrid::BucketX(int x) const
+{
+	return Clamp(x / BucketWidth, 0, gridSize.w - 1);
+}
+
+int ActorGrid::BucketY(int y) const
+{
+	return Clamp(y / BucketHeight, 0, gridSize.h - 1);
+}
+
+size_t ActorGrid::BucketFor(const Point& p) const
+{
+	return BucketY(p.y) * gridSize.w + BucketX(p.x);
+}
+
+void ActorGrid::Insert(Actor* actor)
+{
+	if (buckets.empty() || slots.count(actor)) return;
+
+	Slot slot { BucketFor(actor->Pos), nextSeq++ };
+	slots.emplace(actor, slot);
+	buckets[slot.bucket].push_back({ actor, slot.seq });
+	maxCircleSize = std::max(maxCircleSize, actor->circleSize);
+}
+
+void ActorGrid::Remove(const Scriptable* actor)
+{
+	auto it = slots.find(actor);
+	if (it == slots.end()) return;
+
+	std::vector<Entry>& bucket = buckets[it->second.bucket];
+	for (auto entry = bucket.begin(); entry != bucket.end(); ++entry) {
+		if (entry->actor == actor) {
+			bucket.erase(entry);
+			break;
+		}
+	}
+	slots.erase(it);
+}
+
+void ActorGrid::Update(const Scriptable* actor)
+{
+	auto it = slots.find(actor);
+	if (it == slots.end()) return;
+
+	std::vector<Entry>& bucket = buckets[it->second.bucket];
+	auto entry = bucket.begin();
+	while (entry != bucket.end() && entry->actor != actor) ++entry;
+	// can't happen while the slots are kept in sync
+	if (entry == bucket.end()) return;
+
+	// circles change with the animation, eg. on polymorphing
+	maxCircleSize = std::max(maxCircleSize, entry->actor->circleSize);
+
+	size_t newBucket = BucketFor(actor->Pos);
+	if (newBucket == it->second.bucket) return;
+
+	Entry moved = *entry;
+	*entry = bucket.back();
+	bucket.pop_back();
+	buckets[newBucket].push_back(moved);
+	it->second.bucket = newBucket;
+}
+
+bool ActorGrid::Check(const std::vector<Actor*>& actors) const
+{
+	bool ok = true;
+	if (slots.size() != actors.size()) {
+		Log(ERROR, "ActorGrid", "Tracking {} actors, but the map has {}!", slots.size(), actors.size());
+		ok = false;
+	}
+
+	uint32_t lastSeq = 0;
+	for (const Actor* actor : actors) {
+		auto it = slots.find(actor);
+		if (it == slots.end()) {
+			Log(ERROR, "ActorGrid", "{} is missing from the grid!", fmt::WideToChar{actor->GetShortName()});
+			ok = false;
+			continue;
+		}
+		if (it->second.bucket != BucketFor(actor->Pos)) {
+			Log(ERROR, "ActorGrid", "{} is in the wrong bucket, position {}!", fmt::WideToChar{actor->GetShortName()}, actor->Pos);
+			ok = false;
+		}
+		if (it->second.seq < lastSeq) {
+			Log(ERROR, "ActorGrid", "{} is out of order!", fmt::WideToChar{actor->GetShortName()});
+			ok = false;
+		}
+		lastSeq = it->second.seq;
+	}
+	return ok;
+}
+
+}
@@ -0,0 +1,103 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTORGRID_H
+#define ACTORGRID_H
+
+#include "exports.h"
+
+#include "Region.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+class Scriptable;
+
+// Uniform grid of the actors on a map, so position queries only have to look
+// at the actors near the point instead of all of them.
+// Every actor also gets a sequence number in the order it was added, which
+// matches its order in the map's actor list, so queries can keep returning
+// the same actor a plain scan would.
+class GEM_EXPORT ActorGrid {
+public:
+	static constexpr int BucketCells = 4; // in searchmap cells
+	static constexpr int BucketWidth = BucketCells * 16;
+	static constexpr int BucketHeight = BucketCells * 12;
+
+	struct Entry {
+		Actor* actor;
+		uint32_t seq;
+	};
+
+	// size is in searchmap cells
+	void Reset(const Size& mapSize);
+	void Insert(Actor* actor);
+	void Remove(const Scriptable* actor);
+	// has to be called whenever the position of an actor changes
+	void Update(const Scriptable* actor);
+
+	// calls func for all the actors that may be within the navmap region,
+	// the region is grown by the largest circle first
+	template <typename F>
+	void ForEachNear(const Region& rgn, F&& func) const
+	{
+		if (buckets.empty()) return;
+		int grow = (std::max(maxCircleSize, 2) - 1) * 16;
+		int x1 = BucketX(rgn.x - grow);
+		int x2 = BucketX(rgn.x + rgn.w + grow);
+		int y1 = BucketY(rgn.y - grow);
+		int y2 = BucketY(rgn.y + rgn.h + grow);
+		for (int y = y1; y <= y2; ++y) {
+			for (int x = x1; x <= x2; ++x) {
+				for (const Entry& entry : buckets[y * gridSize.w + x]) {
+					func(entry);
+				}
+			}
+		}
+	}
+
+	// returns false and logs the offenders if the grid got out of sync with the actor list
+	bool Check(const std::vector<Actor*>& actors) const;
+
+private:
+	struct Slot {
+		size_t bucket;
+		uint32_t seq;
+	};
+
+	Size gridSize;
+	std::vector<std::vector<Entry>> buckets;
+	std::unordered_map<const Scriptable*, Slot> slots;
+	uint32_t nextSeq = 0;
+	int maxCircleSize = 0;
+
+	int BucketX(int x) const;
+	int BucketY(int y) const;
+	size_t BucketFor(const Point& p) const;
+};
+
+}
+
+#endif
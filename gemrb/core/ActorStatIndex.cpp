@@ -0,0 +1,147 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorStatIndex.h"
+
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+constexpr std::array<unsigned int, 7> ActorStatIndex::Stats;
+
+int ActorStatIndex::StatPosition(unsigned int stat)
+{
+	for (size_t i = 0; i < Stats.size(); ++i) {
+		if (Stats[i] == stat) return int(i);
+	}
+	return -1;
+}
+
+bool ActorStatIndex::IsIndexed(unsigned int stat)
+{
+	return StatPosition(stat) >= 0;
+}
+
+ActorStatIndex::Bits& ActorStatIndex::Bucket(size_t statIdx, ieDword value)
+{
+	return buckets[statIdx * (ValueCount + 1) + std::min<ieDword>(value, ValueCount)];
+}
+
+void ActorStatIndex::File(size_t slot, bool set)
+{
+	const Slot& entry = slots[slot];
+	uint64_t bit = uint64_t(1) << (slot % 64);
+	for (size_t i = 0; i < Stats.size(); ++i) {
+		Bits& bucket = Bucket(i, entry.values[i]);
+		if (bucket.size() < words) {
+			bucket.resize(words, 0);
+		}
+		if (set) {
+			bucket[slot / 64] |= bit;
+		} else {
+			bucket[slot / 64] &= ~bit;
+		}
+	}
+}
+
+void ActorStatIndex::Insert(Actor* actor)
+{
+	if (slotOf.count(actor)) return;
+
+	size_t slot;
+	if (freeSlots.empty()) {
+		slot = slots.size();
+		slots.emplace_back();
+		words = (slots.size() + 63) / 64;
+	} else {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+
+	Slot& entry = slots[slot];
+	entry.actor = actor;
+	entry.seq = nextSeq++;
+	for (size_t i = 0; i < Stats.size(); ++i) {
+		entry.values[i] = actor->GetStat(Stats[i]);
+	}
+	slotOf.emplace(actor, slot);
+	File(slot, true);
+}
+
+void ActorStatIndex::Remove(const Actor* actor)
+{
+	auto it = slotOf.find(actor);
+	if (it == slotOf.end()) return;
+
+	size_t slot = it->second;
+	File(slot, false);
+	slots[slot].actor = nullptr;
+	freeSlots.push_back(slot);
+	slotOf.erase(it);
+}
+
+void ActorStatIndex::Update(const Actor* actor)
+{
+	auto it = slotOf.find(actor);
+	if (it == slotOf.end()) return;
+
+	size_t slot = it->second;
+	Slot& entry = slots[slot];
+	bool changed = false;
+	for (size_t i = 0; i < Stats.size(); ++i) {
+		if (entry.values[i] != actor->GetStat(Stats[i])) {
+			changed = true;
+			break;
+		}
+	}
+	if (!changed) return;
+
+	File(slot, false);
+	for (size_t i = 0; i < Stats.size(); ++i) {
+		entry.values[i] = actor->GetStat(Stats[i]);
+	}
+	File(slot, true);
+}
+
+void ActorStatIndex::Collect(const Bits& candidates, std::vector<Actor*>& actors) const
+{
+	std::vector<const Slot*> found;
+	for (size_t w = 0; w < candidates.size(); ++w) {
+		uint64_t word = candidates[w];
+		while (word) {
+			size_t bit = 0;
+			while (!(word & (uint64_t(1) << bit))) ++bit;
+			word &= ~(uint64_t(1) << bit);
+			found.push_back(&slots[w * 64 + bit]);
+		}
+	}
+
+	std::sort(found.begin(), found.end(), [](const Slot* a, const Slot* b) {
+		return a->seq < b->seq;
+	});
+	actors.clear();
+	for (const Slot* slot : found) {
+		actors.push_back(slot->actor);
+	}
+}
+
+}
@@ -0,0 +1,112 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTORSTATINDEX_H
+#define ACTORSTATINDEX_H
+
+#include "exports.h"
+#include "ie_stats.h"
+#include "ie_types.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+
+// Per map index of the actors by the stats used in IDS object matching
+// ([EA.GENERAL.RACE...]), so the matching only needs to look at actors that
+// can possibly pass. Every actor gets a slot and each (stat, value) pair a
+// bitset of slots. Values that don't fit a byte go to an overflow set, which
+// is part of every match, so the index never hides an actor.
+class GEM_EXPORT ActorStatIndex {
+public:
+	using Bits = std::vector<uint64_t>;
+
+	static constexpr std::array<unsigned int, 7> Stats {{
+		IE_EA, IE_GENERAL, IE_RACE, IE_SPECIFIC, IE_SEX, IE_SUBRACE, IE_TEAM
+	}};
+	static constexpr int ValueCount = 256;
+
+	static bool IsIndexed(unsigned int stat);
+
+	void Insert(Actor* actor);
+	void Remove(const Actor* actor);
+	// has to be called when the indexed stats of the actor may have changed
+	void Update(const Actor* actor);
+
+	// narrows the candidates to the actors with a value of stat passing the predicate
+	// if narrowed is false, the candidates are initialized first
+	template <typename P>
+	void Narrow(unsigned int stat, P&& pred, Bits& candidates, bool& narrowed) const
+	{
+		int statIdx = StatPosition(stat);
+		if (statIdx < 0) return;
+
+		Bits mask(words, 0);
+		const Bits* statBuckets = &buckets[statIdx * (ValueCount + 1)];
+		for (int value = 0; value <= ValueCount; ++value) {
+			// the overflow set always counts as a match
+			if (value < ValueCount && !pred(value)) continue;
+			const Bits& bucket = statBuckets[value];
+			for (size_t w = 0; w < bucket.size(); ++w) {
+				mask[w] |= bucket[w];
+			}
+		}
+
+		if (narrowed) {
+			for (size_t w = 0; w < words; ++w) {
+				candidates[w] &= mask[w];
+			}
+		} else {
+			candidates = std::move(mask);
+			narrowed = true;
+		}
+	}
+
+	// the actors in the candidate set, in the order they were added to the map
+	void Collect(const Bits& candidates, std::vector<Actor*>& actors) const;
+
+private:
+	struct Slot {
+		Actor* actor = nullptr;
+		uint32_t seq = 0;
+		std::array<ieDword, Stats.size()> values {};
+	};
+
+	std::vector<Slot> slots;
+	std::vector<size_t> freeSlots;
+	std::unordered_map<const Actor*, size_t> slotOf;
+	std::vector<Bits> buckets = std::vector<Bits>(Stats.size() * (ValueCount + 1));
+	size_t words = 0;
+	uint32_t nextSeq = 0;
+
+	static int StatPosition(unsigned int stat);
+	Bits& Bucket(size_t statIdx, ieDword value);
+	void File(size_t slot, bool set);
+};
+
+}
+
+#endif
@@ -430,6 +430,35 @@ void EffectQueue::AddEffect(Effect* fx, bool insert)
 		effects.push_back(std::move(*fx));
 	}
 	delete fx;
+
+	if (indexStale) return;
+	if (insert) {
+		auto& slots = opcodeIndex[effects.front().Opcode];
+		slots.insert(slots.begin(), effects.begin());
+	} else {
+		opcodeIndex[effects.back().Opcode].push_back(std::prev(effects.end()));
+	}
+}
+
+const std::vector<EffectQueue::queue_t::iterator>& EffectQueue::OpcodeEffects(ieDword opcode) const
+{
+	static const std::vector<queue_t::iterator> none;
+
+	if (indexStale) {
+		opcodeIndex.clear();
+		// the index only hands out const access in const methods
+		auto& queue = const_cast<queue_t&>(effects);
+		for (auto f = queue.begin(); f != queue.end(); ++f) {
+			opcodeIndex[f->Opcode].push_back(f);
+		}
+		indexStale = false;
+	}
+
+	auto slots = opcodeIndex.find(opcode);
+	if (slots == opcodeIndex.end()) {
+		return none;
+	}
+	return slots->second;
 }
 
 //This method can remove an effect described by a pointer to it, or
@@ -439,6 +468,7 @@ bool EffectQueue::RemoveEffect(const Effect* fx)
 	for (auto f = effects.begin(); f != effects.end(); ++f) {
 		if (*fx == *f) {
 			effects.erase(f);
+			indexStale = true;
 			return true;
 		}
 	}
@@ -467,6 +497,7 @@ void EffectQueue::Cleanup()
 	for (auto f = effects.begin(); f != effects.end(); ) {
 		if (f->TimingMode == FX_DURATION_JUST_EXPIRED) {
 			f = effects.erase(f);
+			indexStale = true;
 		} else {
 			++f;
 		}
@@ -1261,8 +1292,14 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 		}
 	}
 
+	ieDword opcode = fx->Opcode;
 	res = ed(Owner, target, fx);
 	fx->FirstApply = 0;
+	// some effects turn themselves into others
+	if (fx->Opcode != opcode) {
+		indexStale = true;
+		if (target) target->fxqueue.indexStale = true;
+	}
 
 	switch (res) {
 		case FX_APPLIED:
@@ -1320,7 +1357,8 @@ static inline bool IsLive(ieByte timingmode)
 //will be killed along with it
 void EffectQueue::RemoveAllEffects(ieDword opcode)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1497,7 +1535,8 @@ void EffectQueue::RemoveAllEffects(EffectRef &effect_reference)
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithResource(ieDword opcode, const ResRef &resource)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) { continue; }
@@ -1516,7 +1555,8 @@ void EffectQueue::RemoveAllEffectsWithResource(EffectRef &effect_reference, cons
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithSource(ieDword opcode, const ResRef &source, int mode)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		if (fx.SourceRef != source) continue;
 
@@ -1547,7 +1587,8 @@ void EffectQueue::RemoveAllEffectsWithSource(EffectRef &effectReference, const R
 //(works only if a higher stat means good for the target)
 void EffectQueue::RemoveAllDetrimentalEffects(ieDword opcode, ieDword current)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1581,7 +1622,8 @@ void EffectQueue::RemoveAllDetrimentalEffects(EffectRef &effect_reference, ieDwo
 //opcode need to be removed (see removal of portrait icon)
 void EffectQueue::RemoveAllEffectsWithParam(ieDword opcode, ieDword param2)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1600,7 +1642,8 @@ void EffectQueue::RemoveAllEffectsWithParam(EffectRef &effect_reference, ieDword
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithParamAndResource(ieDword opcode, ieDword param2, const ResRef &resource)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1730,7 +1773,8 @@ bool EffectQueue::RollDispelChance(ieDword casterLevel, ieDword level)
 
 const Effect *EffectQueue::HasOpcode(ieDword opcode) const
 {
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1750,7 +1794,8 @@ const Effect *EffectQueue::HasEffect(EffectRef &effect_reference) const
 
 Effect *EffectQueue::HasOpcode(ieDword opcode)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1770,7 +1815,8 @@ Effect *EffectQueue::HasEffect(EffectRef &effect_reference)
 
 const Effect *EffectQueue::HasOpcodeWithParam(ieDword opcode, ieDword param2) const
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1795,7 +1841,8 @@ const Effect *EffectQueue::HasEffectWithParam(EffectRef &effect_reference, ieDwo
 
 const Effect *EffectQueue::HasOpcodeWithParamPair(ieDword opcode, ieDword param1, ieDword param2) const
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1823,7 +1870,8 @@ const Effect *EffectQueue::HasEffectWithParamPair(EffectRef &effect_reference, i
 bool EffectQueue::DecreaseParam1OfEffect(ieDword opcode, ieDword amount)
 {
 	bool found = false;
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		ieDword& amount_left = fx.Parameter1;
@@ -1851,7 +1899,8 @@ bool EffectQueue::DecreaseParam1OfEffect(EffectRef &effect_reference, ieDword am
 //returns the damage amount NOT soaked
 int EffectQueue::DecreaseParam3OfEffect(ieDword opcode, ieDword amount, ieDword param2)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1890,7 +1939,8 @@ static const int ids_stats[9]={IE_FACTION, IE_TEAM, IE_EA, IE_GENERAL, IE_RACE,
 int EffectQueue::BonusAgainstCreature(ieDword opcode, const Actor *actor) const
 {
 	ieDword sum = 0;
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (fx.Parameter1) {
@@ -1942,7 +1992,8 @@ int EffectQueue::BonusAgainstCreature(EffectRef &effect_reference, const Actor *
 int EffectQueue::BonusForParam2(ieDword opcode, ieDword param2) const
 {
 	int sum = 0;
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1964,7 +2015,8 @@ int EffectQueue::MaxParam1(ieDword opcode, bool positive) const
 {
 	int max = 0;
 	ieDwordSigned param1 = 0;
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1987,7 +2039,8 @@ int EffectQueue::MaxParam1(EffectRef &effect_reference, bool positive) const
 
 bool EffectQueue::WeaponImmunity(ieDword opcode, int enchantment, ieDword weapontype) const
 {
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -2047,7 +2100,8 @@ int EffectQueue::SumDamageReduction(EffectRef &effect_reference, ieDword weaponE
 	int remaining = 0;
 	int count = 0;
 
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -2068,7 +2122,8 @@ int EffectQueue::SumDamageReduction(EffectRef &effect_reference, ieDword weaponE
 //useful for immunity vs spell, can't use item, etc.
 const Effect *EffectQueue::HasOpcodeWithResource(ieDword opcode, const ResRef &resource) const
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) continue;
@@ -2093,7 +2148,8 @@ const Effect *EffectQueue::HasEffectWithPower(EffectRef &effect_reference, ieDwo
 
 const Effect *EffectQueue::HasOpcodeWithPower(ieDword opcode, ieDword power) const
 {
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		// NOTE: matching greater or equals!
@@ -2121,7 +2177,8 @@ const Effect *EffectQueue::HasSource(const ResRef &removed) const
 //used in contingency/sequencer code (cannot have the same contingency twice)
 const Effect *EffectQueue::HasOpcodeWithSource(ieDword opcode, const ResRef &removed) const
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (removed != fx.SourceRef) {
@@ -2208,7 +2265,8 @@ ieDword EffectQueue::CountEffects(ieDword opcode, ieDword param1, ieDword param2
 {
 	ieDword cnt = 0;
 
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		if( param1!=0xffffffff)
 			MATCH_PARAM1()
@@ -2225,7 +2283,8 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effect_reference, const Effe
 	ieDword cnt = 1;
 	ieDword opcode = ResolveEffect(effect_reference);
 
-	for (const auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		const Effect& fx = *f;
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (&fx == fx2) break;
@@ -2236,7 +2295,8 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effect_reference, const Effe
 
 void EffectQueue::ModifyEffectPoint(ieDword opcode, ieDword x, ieDword y)
 {
-	for (auto& fx : effects) {
+	for (auto f : OpcodeEffects(opcode)) {
+		Effect& fx = *f;
 		MATCH_OPCODE()
 		fx.Pos = Point(x, y);
 		fx.Parameter3 = 0;
@@ -37,6 +37,8 @@
 
 #include <cstdlib>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace GemRB {
 
@@ -219,9 +221,26 @@ private:
 	queue_t effects;
 	/** Actor which is target of the Effects */
 	Scriptable* Owner = nullptr;
+	/** Effects of each opcode in queue order, so opcode queries can skip the rest.
+	 * Added effects are indexed directly, removals and opcode changes make it stale */
+	using opcode_index_t = std::unordered_map<ieDword, std::vector<queue_t::iterator>>;
+	mutable opcode_index_t opcodeIndex;
+	mutable bool indexStale = true;
+
+	const std::vector<queue_t::iterator>& OpcodeEffects(ieDword opcode) const;
 
 public:
 	EffectQueue() noexcept {};
+	EffectQueue(const EffectQueue& other) : effects(other.effects), Owner(other.Owner) {}
+	EffectQueue(EffectQueue&&) noexcept = default;
+	EffectQueue& operator=(const EffectQueue& other)
+	{
+		effects = other.effects;
+		Owner = other.Owner;
+		indexStale = true;
+		return *this;
+	}
+	EffectQueue& operator=(EffectQueue&&) noexcept = default;
 	
 	explicit operator bool() const {
 		return !effects.empty();
@@ -34,6 +34,9 @@ FogRenderer::FogRenderer(Video *video, bool doBAMRendering) :
 {}
 
 void FogRenderer::DrawFog(const FogMapData& mapData) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+
 	const Size& fogSize = mapData.fogSize;
 	auto largeFog = mapData.largeFog;
 
@@ -50,6 +53,21 @@ void FogRenderer::DrawFog(const FogMapData& mapData) {
 
 	DrawVPBorders();
 
+	// the fog debug mode switches back to drawing cell by cell, for comparison
+	double* average;
+	if (videoCanRenderGeometry && !core->InDebugMode(ID_FOG)) {
+		DrawFogAlphaMap(mapData);
+		average = &drawTimes.alphaMap;
+	} else {
+		DrawFogCells(mapData);
+		average = &drawTimes.perCell;
+	}
+
+	double elapsed = duration<double, std::milli>(steady_clock::now() - begin).count();
+	*average = *average ? *average * 0.95 + elapsed * 0.05 : elapsed;
+}
+
+void FogRenderer::DrawFogCells(const FogMapData& mapData) {
 	for (int y = start.y; y < end.y; y++) {
 		int unexploredQueue = 0;
 		int shroudedQueue = 0;
@@ -95,6 +113,103 @@ void FogRenderer::DrawFog(const FogMapData& mapData) {
 	}
 }
 
+static uint8_t CellAlpha(bool explored, bool visible)
+{
+	if (!explored) return 255;
+	return visible ? 0 : 128;
+}
+
+void FogRenderer::UpdateFogAlpha(const FogMapData& mapData) {
+	const Size& fogSize = mapData.fogSize;
+	int cells = fogSize.w * fogSize.h;
+	int bytes = (cells + 7) / 8;
+
+	if (alphaSize != fogSize) {
+		// a new map, so everything changed
+		alphaSize = fogSize;
+		fogAlpha.assign(cells, 255);
+		lastExplored.assign(bytes, 0);
+		lastVisible.assign(bytes, 0);
+		alphaChanged = true;
+		for (int i = 0; i < cells; ++i) {
+			fogAlpha[i] = CellAlpha(IsUncovered(Point(i % fogSize.w, i / fogSize.w), mapData.exploredMask),
+				IsUncovered(Point(i % fogSize.w, i / fogSize.w), mapData.visibleMask));
+		}
+		if (mapData.exploredMask) std::copy(mapData.exploredMask->begin(), mapData.exploredMask->end(), lastExplored.begin());
+		else lastExplored.assign(bytes, 0xff);
+		if (mapData.visibleMask) std::copy(mapData.visibleMask->begin(), mapData.visibleMask->end(), lastVisible.begin());
+		else lastVisible.assign(bytes, 0xff);
+		return;
+	}
+
+	// the masks are missing when the debug flags show everything
+	const uint8_t* explored = mapData.exploredMask ? mapData.exploredMask->begin() : nullptr;
+	const uint8_t* visible = mapData.visibleMask ? mapData.visibleMask->begin() : nullptr;
+	for (int b = 0; b < bytes; ++b) {
+		uint8_t exploredByte = explored ? explored[b] : 0xff;
+		uint8_t visibleByte = visible ? visible[b] : 0xff;
+		if (exploredByte == lastExplored[b] && visibleByte == lastVisible[b]) continue;
+
+		lastExplored[b] = exploredByte;
+		lastVisible[b] = visibleByte;
+		alphaChanged = true;
+		for (int bit = 0; bit < 8 && b * 8 + bit < cells; ++bit) {
+			fogAlpha[b * 8 + bit] = CellAlpha(exploredByte & (1 << bit), visibleByte & (1 << bit));
+		}
+	}
+}
+
+void FogRenderer::BuildFogMesh(const FogMapData& mapData) {
+	const Size& fogSize = mapData.fogSize;
+	// outside the map counts as unexplored, unless the masks are off
+	uint8_t outside = CellAlpha(!mapData.exploredMask, !mapData.visibleMask);
+	auto AlphaAt = [&](int x, int y) {
+		if (x < 0 || y < 0 || x >= fogSize.w || y >= fogSize.h) return outside;
+		return fogAlpha[y * fogSize.w + x];
+	};
+
+	meshVertices.clear();
+	meshColors.clear();
+	for (int y = start.y - 1; y < end.y; y++) {
+		for (int x = start.x - 1; x < end.x; x++) {
+			uint8_t nw = AlphaAt(x, y);
+			uint8_t ne = AlphaAt(x + 1, y);
+			uint8_t sw = AlphaAt(x, y + 1);
+			uint8_t se = AlphaAt(x + 1, y + 1);
+			if (!(nw | ne | sw | se)) continue;
+
+			Point c = ConvertPointToScreen(x, y) + Point(CELL_SIZE / 2, CELL_SIZE / 2);
+			float left = c.x;
+			float top = c.y;
+			float right = c.x + CELL_SIZE;
+			float bottom = c.y + CELL_SIZE;
+			meshVertices.insert(meshVertices.end(), {
+				left, top, right, top, left, bottom,
+				right, top, right, bottom, left, bottom
+			});
+			meshColors.insert(meshColors.end(), {
+				Color(0, 0, 0, nw), Color(0, 0, 0, ne), Color(0, 0, 0, sw),
+				Color(0, 0, 0, ne), Color(0, 0, 0, se), Color(0, 0, 0, sw)
+			});
+		}
+	}
+
+	meshP0 = p0;
+	meshStart = start;
+	meshEnd = end;
+	alphaChanged = false;
+}
+
+void FogRenderer::DrawFogAlphaMap(const FogMapData& mapData) {
+	UpdateFogAlpha(mapData);
+	if (alphaChanged || p0 != meshP0 || start != meshStart || end != meshEnd) {
+		BuildFogMesh(mapData);
+	}
+	if (!meshVertices.empty()) {
+		video->DrawRawGeometry(meshVertices, meshColors, BlitFlags::BLENDED);
+	}
+}
+
 Point FogRenderer::ConvertPointToFog(Point p) {
 	return Point(p.x / 32, p.y / 32);
 }
@@ -21,6 +21,7 @@
 #ifndef FOG_RENDERER_H
 #define FOG_RENDERER_H
 
+#include <chrono>
 #include <vector>
 
 #include "exports.h"
@@ -94,12 +95,43 @@ class GEM_EXPORT FogRenderer {
 
 		static constexpr BlitFlags OPAQUE_FOG = BlitFlags::NONE;
 		static constexpr BlitFlags TRANSPARENT_FOG = static_cast<BlitFlags>(BlitFlags::HALFTRANS | BlitFlags::BLENDED);
+
+		// The fog as a low resolution alpha map, one byte per cell: 255 for
+		// unexplored, 128 for explored but not visible and 0 for visible.
+		// Only cells whose bits changed get updated. The map is drawn as a
+		// single batch of quads between the cell centres, so the alpha is
+		// interpolated like a filtered upscale of the map.
+		std::vector<uint8_t> fogAlpha;
+		std::vector<uint8_t> lastExplored;
+		std::vector<uint8_t> lastVisible;
+		Size alphaSize;
+		bool alphaChanged = true;
+
+		std::vector<float> meshVertices;
+		std::vector<Color> meshColors;
+		Point meshP0;
+		Point meshStart;
+		Point meshEnd;
+
 	public:
+		struct DrawTimes {
+			// running averages of DrawFog, in milliseconds
+			double alphaMap = 0.0;
+			double perCell = 0.0;
+		};
+
 		FogRenderer(Video*, bool doBAMRendering = false);
 
 		void DrawFog(const FogMapData& mapData);
+		const DrawTimes& GetDrawTimes() const { return drawTimes; }
 
 	private:
+		DrawTimes drawTimes;
+
+		void DrawFogCells(const FogMapData& mapData);
+		void DrawFogAlphaMap(const FogMapData& mapData);
+		void UpdateFogAlpha(const FogMapData& mapData);
+		void BuildFogMesh(const FogMapData& mapData);
 		Point ConvertPointToScreen(int x, int y) const;
 		static Point ConvertPointToFog(Point p);
 		void DrawExploredCell(Point cellPoint, const Bitmap *mask);
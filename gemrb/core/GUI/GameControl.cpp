@@ -279,17 +279,17 @@ void GameControl::CreateMovement(Actor *actor, const Point &p, bool append, bool
 	tryToRun |= AlwaysRun;
 	
 	if (append) {
-		action = GenerateAction(fmt::format("AddWayPoint([{}.{}])", p.x, p.y));
+		action = GenerateActionAt("AddWayPoint([0.0])", p);
 		assert(action);
 	} else {
 		//try running (in PST) only if not encumbered
 		if (tryToRun && CanRun(actor)) {
-			action = GenerateAction(fmt::format("RunToPoint([{}.{}])", p.x, p.y));
+			action = GenerateActionAt("RunToPoint([0.0])", p);
 		}
 		
 		// check again because GenerateAction can fail (non PST)
 		if (!action) {
-			action = GenerateAction(fmt::format("MoveToPoint([{}.{}])", p.x, p.y));
+			action = GenerateActionAt("MoveToPoint([0.0])", p);
 		}
 	}
 
@@ -869,7 +869,7 @@ bool GameControl::OnKeyRelease(const KeyboardEvent& Key, unsigned short Mod)
 			case 'k': //kicks out actor
 				if (lastActor && lastActor->InParty) {
 					lastActor->Stop();
-					lastActor->AddAction( GenerateAction("LeaveParty()") );
+					lastActor->AddAction( GenerateActionFromTemplate("LeaveParty()") );
 				}
 				break;
 			case 'l': //play an animation (vvc/bam) over an actor
@@ -942,7 +942,7 @@ bool GameControl::OnKeyRelease(const KeyboardEvent& Key, unsigned short Mod)
 			case 'q': //joins actor to the party
 				if (lastActor && !lastActor->InParty) {
 					lastActor->Stop();
-					lastActor->AddAction( GenerateAction("JoinParty()") );
+					lastActor->AddAction( GenerateActionFromTemplate("JoinParty()") );
 				}
 				break;
 			case 'r'://resurrects actor
@@ -1413,6 +1413,9 @@ void GameControl::DebugPaint(const Point& p, bool sample) const noexcept
 			DebugPropVal = map->tileProps.QueryTileProp(tile, prop);
 		} else {
 			map->tileProps.SetTileProp(tile, prop, DebugPropVal);
+			if (prop == TileProps::Property::SEARCH_MAP) {
+				map->SearchMapChanged(Region(tile, Size(1, 1)));
+			}
 		}
 	}
 }
@@ -1698,8 +1701,7 @@ void GameControl::TryToDefend(Actor *source, const Actor *tgt) const
 void GameControl::TryToPick(Actor *source, const Scriptable *tgt) const
 {
 	source->SetModal(MS_NONE);
-	std::string cmdString;
-	cmdString.reserve(20);
+	const char* cmdString;
 	switch (tgt->Type) {
 		case ST_ACTOR:
 			cmdString = "PickPockets([-1])";
@@ -1716,7 +1718,7 @@ void GameControl::TryToPick(Actor *source, const Scriptable *tgt) const
 			Log(ERROR, "GameControl", "Invalid pick target of type {}", tgt->Type);
 			return;
 	}
-	source->CommandActor(GenerateActionDirect(std::move(cmdString), tgt));
+	source->CommandActor(GenerateActionDirect(cmdString, tgt));
 }
 
 //generate action code for source actor to try to disable trap (only trap type active regions)
@@ -1742,8 +1744,7 @@ void GameControl::TryToCast(Actor *source, const Point &tgt)
 	source->Stop();
 
 	spellCount--;
-	std::string tmp;
-	tmp.reserve(30);
+	const char* tmp;
 	if (spellOrItem>=0) {
 		if (spellIndex<0) {
 			tmp = "SpellPointNoDec(\"\",[0.0])";
@@ -1754,8 +1755,7 @@ void GameControl::TryToCast(Actor *source, const Point &tgt)
 		//using item on target
 		tmp = "UseItemPoint(\"\",[0,0],0)";
 	}
-	Action* action = GenerateAction(std::move(tmp));
-	action->pointParameter=tgt;
+	Action* action = GenerateActionAt(tmp, tgt);
 	if (spellOrItem>=0) {
 		if (spellIndex<0) {
 			action->resref0Parameter = spellName;
@@ -1810,8 +1810,7 @@ void GameControl::TryToCast(Actor *source, const Actor *tgt)
 	}
 
 	spellCount--;
-	std::string tmp;
-	tmp.reserve(20);
+	const char* tmp;
 	if (spellOrItem>=0) {
 		if (spellIndex<0) {
 			tmp = "NIDSpecial7()";
@@ -1822,7 +1821,7 @@ void GameControl::TryToCast(Actor *source, const Actor *tgt)
 		//using item on target
 		tmp = "NIDSpecial5()";
 	}
-	Action* action = GenerateActionDirect(std::move(tmp), tgt);
+	Action* action = GenerateActionDirect(tmp, tgt);
 	if (spellOrItem>=0) {
 		if (spellIndex<0) {
 			action->resref0Parameter = spellName;
@@ -1887,8 +1886,7 @@ void GameControl::HandleContainer(Container *container, Actor *actor)
 	core->SetEventFlag(EF_RESETTARGET);
 
 	if (target_mode == TARGET_MODE_ATTACK) {
-		std::string Tmp = fmt::format("BashDoor(\"{}\")", container->GetScriptName());
-		actor->CommandActor(GenerateAction(std::move(Tmp)));
+		actor->CommandActor(GenerateActionDirect("BashDoor([-1])", container));
 		return;
 	}
 
@@ -1899,7 +1897,7 @@ void GameControl::HandleContainer(Container *container, Actor *actor)
 
 	container->AddTrigger(TriggerEntry(trigger_clicked, actor->GetGlobalID()));
 	core->SetCurrentContainer( actor, container);
-	actor->CommandActor(GenerateAction("UseContainer()"));
+	actor->CommandActor(GenerateActionFromTemplate("UseContainer()"));
 }
 
 //generate action code for actor appropriate for the target mode when the target is a door
@@ -1920,8 +1918,7 @@ void GameControl::HandleDoor(Door *door, Actor *actor)
 	core->SetEventFlag(EF_RESETTARGET);
 
 	if (target_mode == TARGET_MODE_ATTACK) {
-		std::string Tmp = fmt::format("BashDoor(\"{}\")", door->GetScriptName());
-		actor->CommandActor(GenerateAction(std::move(Tmp)));
+		actor->CommandActor(GenerateActionDirect("BashDoor([-1])", door));
 		return;
 	}
 
@@ -1933,7 +1930,7 @@ void GameControl::HandleDoor(Door *door, Actor *actor)
 	door->AddTrigger(TriggerEntry(trigger_clicked, actor->GetGlobalID()));
 	actor->TargetDoor = door->GetGlobalID();
 	// internal gemrb toggle door action hack - should we use UseDoor instead?
-	actor->CommandActor(GenerateAction("NIDSpecial9()"));
+	actor->CommandActor(GenerateActionFromTemplate("NIDSpecial9()"));
 }
 
 //generate action code for actor appropriate for the target mode when the target is an active region (infopoint, trap or travel)
@@ -1961,7 +1958,7 @@ bool GameControl::HandleActiveRegion(InfoPoint *trap, Actor * actor, const Point
 		case ST_TRIGGER:
 			// pst, eg. ar1500
 			if (!trap->GetDialog().IsEmpty()) {
-				trap->AddAction(GenerateAction("Dialogue([PC])"));
+				trap->AddAction(GenerateActionFromTemplate("Dialogue([PC])"));
 				return true;
 			}
 
@@ -2000,8 +1997,7 @@ bool GameControl::HandleActiveRegion(InfoPoint *trap, Actor * actor, const Point
 			}
 
 			if (trap->GetUsePoint() ) {
-				std::string Tmp = fmt::format("TriggerWalkTo(\"{}\")", trap->GetScriptName());
-				actor->CommandActor(GenerateAction(std::move(Tmp)));
+				actor->CommandActor(GenerateActionDirect("TriggerWalkTo([-1])", trap));
 				return true;
 			}
 			return true;
@@ -2312,7 +2308,7 @@ void GameControl::CommandSelectedMovement(const Point& p, bool append, bool tryT
 
 	// p is a searchmap travel region or a plain travel region in pst (matching several other criteria)
 	if (party[0]->GetCurrentArea()->GetCursor(p) == IE_CURSOR_TRAVEL || doWorldMap) {
-		party[0]->AddAction(GenerateAction("NIDSpecial2()"));
+		party[0]->AddAction(GenerateActionFromTemplate("NIDSpecial2()"));
 	}
 }
 bool GameControl::OnMouseWheelScroll(const Point& delta)
@@ -71,6 +71,8 @@ int ObjectIDSCount = 7;
 int MaxObjectNesting = 5;
 bool HasAdditionalRect = false;
 bool HasTriggerPoint = false;
+//only evaluate Or() blocks until the first true trigger
+bool EfficientOr = false;
 //don't create new variables
 bool NoCreate = false;
 bool HasKaputz = false;
@@ -1908,6 +1910,7 @@ Action* GenerateActionCore(const char *src, const char *str, unsigned short acti
 		if (*src == ',' || *src==')')
 			src++;
 	}
+	ResolveVariables(newAction);
 	return newAction;
 }
 
@@ -2032,6 +2035,8 @@ Action *ParamCopy(const Action *parameters)
 	newAction->pointParameter = parameters->pointParameter;
 	newAction->string0Parameter = parameters->string0Parameter;
 	newAction->string1Parameter = parameters->string1Parameter;
+	newAction->variableHandles[0] = parameters->variableHandles[0];
+	newAction->variableHandles[1] = parameters->variableHandles[1];
 	for (int c=0;c<3;c++) {
 		newAction->objects[c]= ObjectCopy( parameters->objects[c] );
 	}
@@ -2048,6 +2053,8 @@ Action *ParamCopyNoOverride(const Action *parameters)
 	newAction->pointParameter = parameters->pointParameter;
 	newAction->string0Parameter = parameters->string0Parameter;
 	newAction->string1Parameter = parameters->string1Parameter;
+	newAction->variableHandles[0] = parameters->variableHandles[0];
+	newAction->variableHandles[1] = parameters->variableHandles[1];
 	newAction->objects[0]= NULL;
 	newAction->objects[1]= ObjectCopy( parameters->objects[1] );
 	newAction->objects[2]= ObjectCopy( parameters->objects[2] );
@@ -2179,6 +2186,7 @@ Trigger *GenerateTriggerCore(const char *src, const char *str, int trIndex, int
 		if (*src == ',' || *src==')')
 			src++;
 	}
+	ResolveVariables(newTrigger);
 	return newTrigger;
 }
 
@@ -2277,6 +2285,114 @@ ieDword CheckVariable(const Scriptable *Sender, const StringParam& VarName, VarC
 	return value;
 }
 
+static VariableHandle ResolveVariable(const StringParam& VarName)
+{
+	VariableHandle handle;
+	handle.nameOffset = VarName[6] == ':' ? 7 : 6;
+	handle.hash = Variables::HashKey(Variables::key_t(&VarName[handle.nameOffset]));
+
+	VarContext context;
+	context.Format("{:.6}", VarName);
+	if (context == "MYAREA") {
+		handle.scope = VariableScope::MyArea;
+	} else if (context == "LOCALS") {
+		handle.scope = VariableScope::Locals;
+	} else if (HasKaputz && context == "KAPUTZ") {
+		handle.scope = VariableScope::Kaputz;
+	} else if (context == "GLOBAL") {
+		handle.scope = VariableScope::Global;
+	} else {
+		handle.scope = VariableScope::Area;
+	}
+	return handle;
+}
+
+void ResolveVariables(Trigger* trigger)
+{
+	if (!(triggerflags[trigger->triggerID] & TF_MERGESTRINGS)) {
+		return;
+	}
+	trigger->variableHandles[0] = ResolveVariable(trigger->string0Parameter);
+	trigger->variableHandles[1] = ResolveVariable(trigger->string1Parameter);
+}
+
+void ResolveVariables(Action* action)
+{
+	if (!(actionflags[action->actionID] & AF_MERGESTRINGS)) {
+		return;
+	}
+	action->variableHandles[0] = ResolveVariable(action->string0Parameter);
+	action->variableHandles[1] = ResolveVariable(action->string1Parameter);
+}
+
+static Variables* GetScopeVariables(const Scriptable* Sender, const StringParam& VarName, VariableScope scope)
+{
+	const Game* game = core->GetGame();
+	switch (scope) {
+		case VariableScope::MyArea:
+			return Sender->GetCurrentArea()->locals;
+		case VariableScope::Locals:
+			return Sender->locals;
+		case VariableScope::Kaputz:
+			return game->kaputz;
+		case VariableScope::Global:
+			return game->locals;
+		default:
+			break;
+	}
+	// map name context, eg. AR1324
+	const Map* map = game->GetMap(game->FindMap(VarContext(VarName.c_str(), 6)));
+	return map ? map->locals : nullptr;
+}
+
+static ieDword CheckResolvedVariable(const Scriptable* Sender, const StringParam& VarName, const VariableHandle& handle, bool* valid)
+{
+	if (handle.scope == VariableScope::Unresolved) {
+		return CheckVariable(Sender, VarName, {}, valid);
+	}
+
+	ieDword value = 0;
+	const Variables* vars = GetScopeVariables(Sender, VarName, handle.scope);
+	if (vars) {
+		vars->LookupHashed(Variables::key_t(&VarName[handle.nameOffset]), handle.hash, value);
+	} else {
+		if (valid) *valid = false;
+		ScriptDebugLog(ID_VARIABLES, "Invalid variable {} in checkvariable", VarName);
+	}
+	ScriptDebugLog(ID_VARIABLES, "CheckVariable {}: {}", VarName, value);
+	return value;
+}
+
+ieDword CheckVariable(const Scriptable* Sender, const Trigger* parameters, int param, bool* valid)
+{
+	const StringParam& name = param ? parameters->string1Parameter : parameters->string0Parameter;
+	return CheckResolvedVariable(Sender, name, parameters->variableHandles[param], valid);
+}
+
+ieDword CheckVariable(const Scriptable* Sender, const Action* parameters, int param, bool* valid)
+{
+	const StringParam& name = param ? parameters->string1Parameter : parameters->string0Parameter;
+	return CheckResolvedVariable(Sender, name, parameters->variableHandles[param], valid);
+}
+
+void SetVariable(Scriptable* Sender, const Action* parameters, int param, ieDword value)
+{
+	const StringParam& name = param ? parameters->string1Parameter : parameters->string0Parameter;
+	const VariableHandle& handle = parameters->variableHandles[param];
+	if (handle.scope == VariableScope::Unresolved) {
+		SetVariable(Sender, name, value);
+		return;
+	}
+
+	ScriptDebugLog(ID_VARIABLES, "Setting variable(\"{}\", {})", name, value);
+	Variables* vars = GetScopeVariables(Sender, name, handle.scope);
+	if (vars) {
+		vars->SetAtHashed(Variables::key_t(&name[handle.nameOffset]), handle.hash, value, NoCreate);
+	} else if (core->InDebugMode(ID_VARIABLES)) {
+		Log(WARNING, "GameScript", "Invalid variable {} in SetVariable", name);
+	}
+}
+
 Point CheckPointVariable(const Scriptable *Sender, const StringParam& VarName, const VarContext& Context, bool *valid)
 {
 	ieDword val = CheckVariable(Sender, VarName, Context, valid);
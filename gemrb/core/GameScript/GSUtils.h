@@ -52,6 +52,7 @@ extern int ObjectIDSCount;
 extern int MaxObjectNesting;
 extern bool HasAdditionalRect;
 extern bool HasTriggerPoint;
+extern bool EfficientOr;
 extern bool NoCreate;
 extern bool HasKaputz;
 extern std::vector<ResRef> ObjectIDSTableNames;
@@ -131,6 +132,12 @@ GEM_EXPORT void DisplayStringCore(Scriptable* Sender, ieStrRef str, int flags, c
 bool CreateMovementEffect(Actor* actor, const ResRef& area, const Point &position, int face);
 GEM_EXPORT void MoveBetweenAreasCore(Actor* actor, const ResRef &area, const Point &position, int face, bool adjust);
 GEM_EXPORT ieDword CheckVariable(const Scriptable *Sender, const StringParam& VarName, VarContext Context = {}, bool *valid = nullptr);
+// the same for a merged variable parameter (0 or 1), using the handle resolved at load time
+ieDword CheckVariable(const Scriptable* Sender, const Trigger* parameters, int param, bool* valid = nullptr);
+ieDword CheckVariable(const Scriptable* Sender, const Action* parameters, int param, bool* valid = nullptr);
+void SetVariable(Scriptable* Sender, const Action* parameters, int param, ieDword value);
+void ResolveVariables(Trigger* trigger);
+void ResolveVariables(Action* action);
 GEM_EXPORT Point CheckPointVariable(const Scriptable *Sender, const StringParam& VarName, const VarContext& Context = {}, bool *valid = nullptr);
 GEM_EXPORT bool VariableExists(const Scriptable *Sender, const StringParam& VarName, const VarContext& Context);
 Action* GenerateActionCore(const char *src, const char *str, unsigned short actionID);
@@ -43,6 +43,7 @@
 
 #include "GameScript/GSUtils.h"
 #include "GameScript/Matching.h"
+#include "GameScript/ScriptProfiler.h"
 
 #include "Game.h"
 #include "GUI/GameControl.h" // just for DF_POSTPONE_SCRIPTS
@@ -52,7 +53,9 @@
 #include "TableMgr.h"
 #include "RNG.h"
 
+#include <algorithm>
 #include <cstdarg>
+#include <unordered_map>
 
 namespace GemRB {
 
@@ -1241,6 +1244,36 @@ static const IDSLink* FindIdentifier(const char* idsname)
 
 /********************** Targets **********************************/
 
+// object filters create and drop a Targets for nearly every evaluated
+// object, so keep the buffers around instead of reallocating them
+static std::vector<targetlist> spareTargetLists;
+
+Targets::Targets() noexcept
+{
+	if (!spareTargetLists.empty()) {
+		objects = std::move(spareTargetLists.back());
+		spareTargetLists.pop_back();
+	}
+}
+
+Targets::~Targets() noexcept
+{
+	if (spareTargetLists.size() < 16 && objects.capacity()) {
+		objects.clear();
+		spareTargetLists.push_back(std::move(objects));
+	}
+}
+
+void Targets::Sort() const
+{
+	if (sorted) return;
+	// stable, so equally distant targets keep their insertion order
+	std::stable_sort(objects.begin(), objects.end(), [](const targettype& a, const targettype& b) {
+		return a.distance < b.distance;
+	});
+	sorted = true;
+}
+
 int Targets::Count() const
 {
 	return (int)objects.size();
@@ -1257,8 +1290,8 @@ targettype *Targets::RemoveTargetAt(targetlist::iterator &m)
 
 const targettype *Targets::GetLastTarget(int Type)
 {
-	targetlist::const_iterator m = objects.end();
-	while (m--!=objects.begin() ) {
+	Sort();
+	for (auto m = objects.rbegin(); m != objects.rend(); ++m) {
 		if (Type == -1 || (*m).actor->Type == Type) {
 			return &(*m);
 		}
@@ -1268,6 +1301,7 @@ const targettype *Targets::GetLastTarget(int Type)
 
 const targettype *Targets::GetFirstTarget(targetlist::iterator &m, int Type)
 {
+	Sort();
 	m=objects.begin();
 	while (m!=objects.end() ) {
 		if (Type != -1 && (*m).actor->Type != Type) {
@@ -1294,6 +1328,7 @@ const targettype *Targets::GetNextTarget(targetlist::iterator &m, int Type)
 
 Scriptable *Targets::GetTarget(unsigned int index, int Type)
 {
+	Sort();
 	targetlist::iterator m = objects.begin();
 	while(m!=objects.end() ) {
 		if (Type == -1 || (*m).actor->Type == Type) {
@@ -1328,23 +1363,21 @@ void Targets::AddTarget(Scriptable* target, unsigned int distance, int ga_flags)
 	default:
 		break;
 	}
-	targettype Target = {target, distance};
-	for (auto m = objects.begin(); m != objects.end(); ++m) {
-		if ( (*m).distance>distance) {
-			objects.insert( m, Target);
-			return;
-		}
+	if (sorted && !objects.empty() && objects.back().distance > distance) {
+		sorted = false;
 	}
-	objects.push_back( Target );
+	objects.push_back({target, distance});
 }
 
 void Targets::Clear()
 {
 	objects.clear();
+	sorted = true;
 }
 
 void Targets::dump() const
 {
+	Sort();
 	Log(DEBUG, "GameScript", "Target dump (actors only):");
 	for (const auto& object : objects) {
 		if (object.actor->Type == ST_ACTOR) {
@@ -1358,18 +1391,18 @@ void Targets::FilterObjectRect(const Object *oC)
 	// can't match anything if the second pair of coordinates (or all of them) are unset
 	if (oC->objectRect.w <= 0 || oC->objectRect.h <= 0) return;
 
-	for (auto m = objects.begin(); m != objects.end();) {
-		if (!IsInObjectRect((*m).actor->Pos, oC->objectRect)) {
-			m = objects.erase(m);
-		} else {
-			++m;
-		}
-	}
+	// erasing keeps the relative order, sorted or not
+	objects.erase(std::remove_if(objects.begin(), objects.end(), [oC](const targettype& t) {
+		return !IsInObjectRect(t.actor->Pos, oC->objectRect);
+	}), objects.end());
 }
 
 /** releasing global memory */
 static void CleanupIEScript()
 {
+	if (!ScriptProfiler::Get().Empty()) {
+		Log(MESSAGE, "GameScript", "{}", GameScript::ProfileReport(20));
+	}
 	triggersTable.reset();
 	actionsTable.reset();
 	objectsTable.reset();
@@ -1479,6 +1512,7 @@ void InitializeIEScript()
 	HasAdditionalRect = objNameTable->QueryFieldSigned<int>(2, 0) != 0;
 	ExtraParametersCount = objNameTable->QueryFieldSigned<int>(3, 0);
 	HasTriggerPoint = objNameTable->QueryFieldSigned<int>(4, 0) != 0;
+	EfficientOr = core->HasFeature(GF_EFFICIENT_OR);
 	ObjectFieldsCount = ObjectIDSCount - ExtraParametersCount;
 
 	/* Initializing the Script Engine */
@@ -1959,6 +1993,7 @@ static Trigger* ReadTrigger(DataStream* stream)
 		delete tR;
 		return NULL;
 	}
+	ResolveVariables(tR);
 	return tR;
 }
 
@@ -1995,11 +2030,39 @@ static Condition* ReadCondition(DataStream* stream)
 			continue;
 		}
 
-		cO->triggers.push_back( tR );
+		cO->AddTrigger(tR);
 	}
+	cO->Compile();
 	return cO;
 }
 
+// times a whole script or one of its blocks, whichever way they are left
+class ProfilerScope {
+	ScriptProfiler::Sample sample;
+	const ResRef& script;
+	const Scriptable* sender;
+	size_t block;
+public:
+	static constexpr size_t WholeScript = size_t(-1);
+
+	ProfilerScope(const ResRef& script, const Scriptable* sender, size_t block = WholeScript)
+		: script(script), sender(sender), block(block) {}
+	ProfilerScope(const ProfilerScope&) = delete;
+	ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+	~ProfilerScope()
+	{
+		if (!sample.Running()) return;
+
+		if (block != WholeScript) {
+			ScriptProfiler::Get().AddBlock(script, block, sample);
+			return;
+		}
+		const Map* area = sender->GetCurrentArea();
+		ScriptProfiler::Get().AddScript(script, area ? area->GetScriptRef() : ResRef(), sample);
+	}
+};
+
 /*
  * if you pass non-NULL parameters, continuing is set to whether we Continue()ed
  * (should start false and be passed to next script's Update),
@@ -2019,6 +2082,7 @@ bool GameScript::Update(bool *continuing, bool *done)
 	if(!(MySelf->GetInternalFlag()&IF_ACTIVE) ) {
 		return false;
 	}
+	ProfilerScope scriptScope(Name, MySelf);
 
 	bool continueExecution = false;
 	if (continuing) continueExecution = *continuing;
@@ -2026,6 +2090,7 @@ bool GameScript::Update(bool *continuing, bool *done)
 	RandomNumValue = RAND_ALL();
 	for (size_t a = 0; a < script->responseBlocks.size(); a++) {
 		ResponseBlock* rB = script->responseBlocks[a];
+		ProfilerScope blockScope(Name, MySelf, a);
 		if (!rB->condition->Evaluate(MySelf)) {
 			continue;
 		}
@@ -2210,6 +2275,7 @@ Response* GameScript::ReadResponse(DataStream* stream)
 				//just to find bugs faster
 				aC->int0Parameter = -1;
 			}
+			ResolveVariables(aC);
 		}
 		rE->actions.push_back( aC );
 		stream->ReadLine(line);
@@ -2219,6 +2285,142 @@ Response* GameScript::ReadResponse(DataStream* stream)
 	return rE;
 }
 
+// parsed action and trigger templates keyed by their lowercased source
+// only the engine's fixed strings get here, so this stays small
+template<typename T>
+class ParsedCache {
+	std::unordered_map<std::string, T*> prototypes;
+
+public:
+	ParsedCache() noexcept = default;
+	ParsedCache(const ParsedCache&) = delete;
+	~ParsedCache()
+	{
+		Clear();
+	}
+	ParsedCache& operator=(const ParsedCache&) = delete;
+
+	const T* Find(const std::string& key) const
+	{
+		auto it = prototypes.find(key);
+		return it == prototypes.end() ? nullptr : it->second;
+	}
+
+	void Add(std::string key, T* prototype)
+	{
+		prototypes.emplace(std::move(key), prototype);
+	}
+
+	void Clear()
+	{
+		for (auto& entry : prototypes) {
+			entry.second->Release();
+		}
+		prototypes.clear();
+	}
+};
+
+static ParsedCache<Action> parsedActions;
+static ParsedCache<Trigger> parsedTriggers;
+
+// Actions and Objects are created and dropped all the time, for movement,
+// attacks, dialog and every parsed action, so they are carved out of blocks
+// and kept on a free list instead of going through the general heap.
+// The blocks are never returned, as cached scripts outlive any static.
+class ScriptPool {
+	union Slot {
+		Slot* next;
+		alignas(std::max_align_t) unsigned char storage[1];
+	};
+	static constexpr size_t SlotsPerBlock = 128;
+
+public:
+	struct Stats {
+		size_t live = 0;
+		size_t peak = 0;
+		size_t blocks = 0; // the only heap allocations
+		unsigned long allocations = 0;
+	};
+
+private:
+	size_t slotSize;
+	Slot* freeList = nullptr;
+	Stats stats;
+
+public:
+
+	explicit ScriptPool(size_t size)
+	: slotSize((std::max(size, sizeof(Slot)) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1)) {}
+
+	void* Allocate()
+	{
+		if (!freeList) {
+			auto block = static_cast<unsigned char*>(::operator new(slotSize * SlotsPerBlock));
+			for (size_t i = SlotsPerBlock; i--;) {
+				Slot* slot = reinterpret_cast<Slot*>(block + i * slotSize);
+				slot->next = freeList;
+				freeList = slot;
+			}
+			stats.blocks++;
+		}
+		Slot* slot = freeList;
+		freeList = slot->next;
+		stats.allocations++;
+		stats.live++;
+		stats.peak = std::max(stats.peak, stats.live);
+		return slot;
+	}
+
+	void Free(void* ptr)
+	{
+		Slot* slot = static_cast<Slot*>(ptr);
+		slot->next = freeList;
+		freeList = slot;
+		stats.live--;
+	}
+
+	const Stats& GetStats() const { return stats; }
+};
+
+static ScriptPool& ActionPool()
+{
+	static ScriptPool* pool = new ScriptPool(sizeof(Action));
+	return *pool;
+}
+
+static ScriptPool& ObjectPool()
+{
+	static ScriptPool* pool = new ScriptPool(sizeof(Object));
+	return *pool;
+}
+
+void* Action::operator new(size_t size)
+{
+	assert(size == sizeof(Action));
+	return ActionPool().Allocate();
+}
+
+void Action::operator delete(void* ptr, size_t /*size*/)
+{
+	ActionPool().Free(ptr);
+}
+
+void* Object::operator new(size_t size)
+{
+	// not final, so anything derived goes to the heap
+	if (size != sizeof(Object)) return ::operator new(size);
+	return ObjectPool().Allocate();
+}
+
+void Object::operator delete(void* ptr, size_t size)
+{
+	if (size != sizeof(Object)) {
+		::operator delete(ptr);
+		return;
+	}
+	ObjectPool().Free(ptr);
+}
+
 void GameScript::ExecuteString(Scriptable* Sender, std::string string)
 {
 	if (string.empty()) {
@@ -2246,6 +2448,92 @@ int GameScript::EvaluateString(Scriptable* Sender, const char* String)
 	return 0;
 }
 
+int GameScript::EvaluateTemplate(Scriptable* Sender, const char* templ)
+{
+	std::string key(templ);
+	StringToLower(key);
+	const Trigger* tri = parsedTriggers.Find(key);
+	if (!tri) {
+		Trigger* parsed = GenerateTrigger(key);
+		if (!parsed) {
+			return 0;
+		}
+		tri = parsed;
+		parsedTriggers.Add(std::move(key), parsed);
+	}
+	return tri->Evaluate(Sender);
+}
+
+static StringView TriggerName(unsigned short triggerID)
+{
+	StringView name = triggersTable->GetValue(triggerID);
+	if (name.empty()) {
+		name = triggersTable->GetValue(triggerID | 0x4000);
+	}
+	return name;
+}
+
+static TriggerFunction ResolveTrigger(unsigned short triggerID)
+{
+	if (triggerID >= MAX_TRIGGERS) {
+		Log(ERROR, "GameScript", "Corrupted (too high) trigger code: {}", triggerID);
+		return nullptr;
+	}
+	TriggerFunction func = triggers[triggerID];
+	if (!func) {
+		// unhandled triggers behave like False(), so negating them still works
+		func = triggers[triggerID] = GameScript::False;
+		Log(WARNING, "GameScript", "Unhandled trigger code: {:#x} {}",
+			triggerID, TriggerName(triggerID));
+	}
+	return func;
+}
+
+static void LogTrigger(unsigned short triggerID, const Scriptable* Sender)
+{
+	ScriptDebugLog(ID_TRIGGERS, "Executing trigger code: {:#x} {} (Sender: {} / {})", triggerID, TriggerName(triggerID), Sender->GetScriptName(), fmt::WideToChar{Sender->GetName()});
+}
+
+void Condition::Compile() const
+{
+	program.clear();
+	program.reserve(triggers.size());
+	for (const Trigger* tR : triggers) {
+		Step step;
+		step.trigger = tR;
+		step.function = ResolveTrigger(tR->triggerID);
+		step.negate = tR->flags & TF_NEGATE;
+		if (step.function == GameScript::Or && !step.negate) {
+			step.isOr = true;
+			step.orCount = tR->int0Parameter;
+		}
+		program.push_back(step);
+	}
+	dirty = false;
+}
+
+int Condition::Step::Evaluate(Scriptable* Sender) const
+{
+	if (core->InDebugMode(ID_TRIGGERS)) {
+		LogTrigger(trigger->triggerID, Sender);
+	}
+	if (isOr) {
+		return orCount;
+	}
+	// invalid trigger codes were reported while compiling
+	if (!function) {
+		return 0;
+	}
+
+	ScriptProfiler::Sample sample;
+	int ret = function(Sender, trigger);
+	ScriptProfiler::Get().AddTrigger(trigger->triggerID, sample);
+	if (negate) {
+		return !ret;
+	}
+	return ret;
+}
+
 bool Condition::Evaluate(Scriptable *Sender) const
 {
 	int ORcount = 0;
@@ -2255,12 +2543,16 @@ bool Condition::Evaluate(Scriptable *Sender) const
 	if (triggers.empty()) {
 		return true;
 	}
+	// conditions are normally compiled on load, this catches later additions
+	if (dirty) {
+		Compile();
+	}
 
-	for (const Trigger *tR : triggers) {
+	for (const Step& step : program) {
 		//do not evaluate triggers in an Or() block if one of them
 		//was already True() ... but this sane approach was only used in iwd2!
-		if (!core->HasFeature(GF_EFFICIENT_OR) || !ORcount || !subresult) {
-			result = tR->Evaluate(Sender);
+		if (!EfficientOr || !ORcount || !subresult) {
+			result = step.Evaluate(Sender);
 		}
 		if (result > 1) {
 			//we started an Or() block
@@ -2295,24 +2587,17 @@ bool Condition::Evaluate(Scriptable *Sender) const
 /* this may return more than a boolean, in case of Or(x) */
 int Trigger::Evaluate(Scriptable *Sender) const
 {
-	if (triggerID >= MAX_TRIGGERS) {
-		Log(ERROR, "GameScript", "Corrupted (too high) trigger code: {}", triggerID);
-		return 0;
-	}
-	TriggerFunction func = triggers[triggerID];
-	StringView tmpstr = triggersTable->GetValue(triggerID);
-	if (tmpstr.empty()) {
-		tmpstr = triggersTable->GetValue(triggerID|0x4000);
-	}
+	TriggerFunction func = ResolveTrigger(triggerID);
 	if (!func) {
-		triggers[triggerID] = GameScript::False;
-		Log(WARNING, "GameScript", "Unhandled trigger code: {:#x} {}",
-			triggerID, tmpstr );
 		return 0;
 	}
-	ScriptDebugLog(ID_TRIGGERS, "Executing trigger code: {:#x} {} (Sender: {} / {})", triggerID, tmpstr, Sender->GetScriptName(), fmt::WideToChar{Sender->GetName()});
+	if (core->InDebugMode(ID_TRIGGERS)) {
+		LogTrigger(triggerID, Sender);
+	}
 
+	ScriptProfiler::Sample sample;
 	int ret = func( Sender, this );
+	ScriptProfiler::Get().AddTrigger(triggerID, sample);
 	if (flags & TF_NEGATE) {
 		return !ret;
 	}
@@ -2381,6 +2666,23 @@ static void PrintAction(std::string& buffer, int actionID)
 	AppendFormat(buffer, "Action: {} {}\n", actionID, actionsTable->GetValue(actionID));
 }
 
+std::string GameScript::ProfileReport(size_t count)
+{
+	auto actionName = [](unsigned int actionID) {
+		return StringView(actionsTable->GetValue(actionID));
+	};
+	std::string report = ScriptProfiler::Get().Report(count, TriggerName, actionName);
+
+	const char* names[] = { "Action", "Object" };
+	const ScriptPool* pools[] = { &ActionPool(), &ObjectPool() };
+	for (int i = 0; i < 2; ++i) {
+		const ScriptPool::Stats& stats = pools[i]->GetStats();
+		AppendFormat(report, "{} pool: {} live, {} at most, {} allocations from {} heap blocks\n",
+			names[i], stats.live, stats.peak, stats.allocations, stats.blocks);
+	}
+	return report;
+}
+
 static void HandleActionOverride(Scriptable* target, const Action* aC)
 {
 	Action *newAction = ParamCopyNoOverride(aC);
@@ -2455,7 +2757,10 @@ void GameScript::ExecuteAction(Scriptable* Sender, Action* aC)
 				return;
 			}
 		}
+		ScriptProfiler::Sample sample;
 		func( Sender, aC );
+		// aC may be gone by now, but the id was saved
+		ScriptProfiler::Get().AddAction(actionID, sample);
 	} else {
 		actions[actionID] = NoAction;
 		std::string buffer("Unknown ");
@@ -2512,11 +2817,10 @@ Trigger* GenerateTrigger(std::string string)
 	return trigger;
 }
 
-Action* GenerateAction(std::string actionString)
+static Action* ParseAction(const std::string& actionString)
 {
 	Action* action = NULL;
-	
-	StringToLower(actionString);
+
 	ScriptDebugLog(ID_ACTIONS, "Compiling: '{}'", actionString);
 
 	auto len = actionString.find_first_of('(') + 1; //including (
@@ -2550,9 +2854,42 @@ Action* GenerateAction(std::string actionString)
 	return action;
 }
 
-Action *GenerateActionDirect(std::string string, const Scriptable *object)
+Action* GenerateAction(std::string actionString)
+{
+	StringToLower(actionString);
+	return ParseAction(actionString);
+}
+
+Action* GenerateActionFromTemplate(const char* templ)
+{
+	std::string key(templ);
+	StringToLower(key);
+	const Action* prototype = parsedActions.Find(key);
+	if (!prototype) {
+		Action* parsed = ParseAction(key);
+		if (!parsed) {
+			return nullptr;
+		}
+		// the cache keeps one reference, the copies are independent
+		parsed->IncRef();
+		prototype = parsed;
+		parsedActions.Add(std::move(key), parsed);
+	}
+	return ParamCopy(prototype);
+}
+
+Action* GenerateActionAt(const char* templ, const Point& point)
+{
+	Action* action = GenerateActionFromTemplate(templ);
+	if (action) {
+		action->pointParameter = point;
+	}
+	return action;
+}
+
+Action *GenerateActionDirect(const char* templ, const Scriptable *object)
 {
-	Action* action = GenerateAction(std::move(string));
+	Action* action = GenerateActionFromTemplate(templ);
 	if (!action) return NULL;
 	Object *tmp = action->objects[1];
 	if (tmp && tmp->objectFields[0]==-1) {
@@ -141,18 +141,42 @@ class GameScript;
 using StringParam = FixedSizeString<64, strnicmp>; // FIXME: should this be case sensetive
 static_assert(std::is_standard_layout<StringParam>::value, "Fixed Size String must be standard layout for use in unions");
 
+// where a merged context and variable name string parameter points to,
+// resolved once when the script is loaded (see ResolveVariables)
+enum class VariableScope : uint8_t {
+	Unresolved, // fall back to parsing the context on each access
+	MyArea,
+	Locals,
+	Kaputz,
+	Global,
+	Area // the context is an area name
+};
+
+struct VariableHandle {
+	unsigned int hash = 0; // Variables::HashKey of the name
+	uint8_t nameOffset = 0; // the name follows the context and maybe a ':'
+	VariableScope scope = VariableScope::Unresolved;
+};
+
 struct targettype {
 	Scriptable *actor; //hmm, could be door
 	unsigned int distance;
 };
 
-using targetlist = std::list<targettype>;
+using targetlist = std::vector<targettype>;
 
 class GEM_EXPORT Targets {
-	targetlist objects;
+	// appended in any order and sorted by distance (stable) on first read
+	mutable targetlist objects;
+	mutable bool sorted = true;
+
+	void Sort() const;
 public:
-	Targets() noexcept {};
-	
+	Targets() noexcept;
+	Targets(const Targets&) = delete;
+	Targets& operator=(const Targets&) = delete;
+	~Targets() noexcept;
+
 	int Count() const;
 	void dump() const;
 	targettype *RemoveTargetAt(targetlist::iterator &m);
@@ -207,6 +231,10 @@ public:
 public:
 	Object() noexcept : objectName() {};
 
+	// recycled through a pool, see ScriptPool in GameScript.cpp
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size);
+
 	std::string dump(bool print = true) const;
 	void Release()
 	{
@@ -234,6 +262,7 @@ public:
 	int int2Parameter = 0;
 	Point pointParameter;
 	Object* objectParameter = nullptr;
+	VariableHandle variableHandles[2];
 	
 	union {
 		StringParam string0Parameter;
@@ -271,8 +300,30 @@ public:
 		delete this;
 	}
 	bool Evaluate(Scriptable *Sender) const;
+	// resolves the triggers into a flat list of steps, so evaluation
+	// doesn't have to go through the lookup tables every time
+	void Compile() const;
+	// takes over the reference; the program is rebuilt before the next evaluation
+	void AddTrigger(Trigger* trigger)
+	{
+		triggers.push_back(trigger);
+		dirty = true;
+	}
 
+private:
 	std::vector<Trigger*> triggers;
+
+	struct Step {
+		int (*function)(Scriptable*, const Trigger*) = nullptr;
+		const Trigger* trigger = nullptr;
+		int orCount = 0; // an unnegated Or(), which just returns its span
+		bool isOr = false;
+		bool negate = false;
+
+		int Evaluate(Scriptable* Sender) const;
+	};
+	mutable std::vector<Step> program;
+	mutable bool dirty = true;
 };
 
 class GEM_EXPORT Action final : protected Canary {
@@ -303,6 +354,7 @@ public:
 	Point pointParameter;
 	int int1Parameter = 0;
 	int int2Parameter = 0;
+	VariableHandle variableHandles[2];
 	
 	union {
 		StringParam string0Parameter; // keep largest type first to 0 fill everythings
@@ -320,6 +372,10 @@ public:
 private:
 	int RefCount = 0;
 public:
+	// recycled through a pool, see ScriptPool in GameScript.cpp
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size);
+
 	int GetRef() const {
 		return RefCount;
 	}
@@ -550,7 +606,11 @@ public:
 	ResRef GetName() const { return Name; }
 	static void ExecuteString(Scriptable* Sender, std::string string);
 	static int EvaluateString(Scriptable* Sender, const char* String);
+	// same for a fixed trigger string, which is only parsed once
+	static int EvaluateTemplate(Scriptable* Sender, const char* templ);
 	static void ExecuteAction(Scriptable* Sender, Action* aC);
+	// the count most expensive entries gathered by the script profiling debug mode
+	static std::string ProfileReport(size_t count);
 
 	bool Update(bool *continuing = NULL, bool *done = NULL);
 	void EvaluateAllBlocks();
@@ -571,6 +631,7 @@ private: //Internal Functions
 public: //Script Functions
 	static int ID_Alignment(const Actor *actor, int parameter);
 	static int ID_Allegiance(const Actor *actor, int parameter);
+	static bool MatchAllegiance(int value, int parameter);
 	static int ID_AVClass(const Actor *actor, int parameter);
 	static int ID_Class(const Actor *actor, int parameter);
 	static int ID_ClassMask(const Actor *actor, int parameter);
@@ -1554,8 +1615,14 @@ public: //Script Functions
 	static Targets *Player10Fill(const Scriptable *Sender, Targets *parameters, int ga_flags);
 };
 
+// parses the string on every call, use it for formatted and user provided strings
 GEM_EXPORT Action* GenerateAction(std::string String);
-GEM_EXPORT Action *GenerateActionDirect(std::string string, const Scriptable *object);
+// action templates are fixed strings, parsed once and then copied on every call
+// the placeholder parameters are slots for the bound arguments:
+// [-1] for the target object and [0.0] for the point; plain parameters are set by the caller
+GEM_EXPORT Action* GenerateActionFromTemplate(const char* templ);
+GEM_EXPORT Action *GenerateActionDirect(const char* templ, const Scriptable *object);
+GEM_EXPORT Action* GenerateActionAt(const char* templ, const Point& point);
 GEM_EXPORT Trigger* GenerateTrigger(std::string string);
 
 void InitializeIEScript();
@@ -142,6 +142,42 @@ static inline bool DoObjectChecks(const Map* map, const Scriptable* Sender, Acto
 	return true;
 }
 
+// IDS functions that only look at a single stat, so the per map index can be used
+// returns false if none of the set fields could narrow down the candidates
+static bool NarrowByIndex(const ActorStatIndex& index, const Object *oC, ActorStatIndex::Bits& candidates)
+{
+	bool narrowed = false;
+	for (int j = 0; j < ObjectIDSCount; j++) {
+		int param = oC->objectFields[j];
+		if (!param) continue;
+
+		IDSFunction func = idtargets[j];
+		if (func == GameScript::ID_Allegiance) {
+			index.Narrow(IE_EA, [param](int value) { return GameScript::MatchAllegiance(value, param); }, candidates, narrowed);
+			continue;
+		}
+
+		unsigned int stat;
+		if (func == GameScript::ID_General) {
+			stat = IE_GENERAL;
+		} else if (func == GameScript::ID_Race) {
+			stat = IE_RACE;
+		} else if (func == GameScript::ID_Specific) {
+			stat = IE_SPECIFIC;
+		} else if (func == GameScript::ID_Gender) {
+			stat = IE_SEX;
+		} else if (func == GameScript::ID_Subrace) {
+			stat = IE_SUBRACE;
+		} else if (func == GameScript::ID_Team) {
+			stat = IE_TEAM;
+		} else {
+			continue;
+		}
+		index.Narrow(stat, [param](int value) { return value == param; }, candidates, narrowed);
+	}
+	return narrowed;
+}
+
 /* returns actors that match the [x.y.z] expression */
 static Targets *EvaluateObject(const Map *map, const Scriptable *Sender, const Object *oC, int ga_flags)
 {
@@ -186,10 +222,16 @@ static Targets *EvaluateObject(const Map *map, const Scriptable *Sender, const O
 	Targets *tgts = NULL;
 
 	//we need to get a subset of actors from the large array
-	//if this gets slow, we will need some index tables
-	int i = map->GetActorCount(true);
+	//the index narrows it down to the actors that can pass the IDS check
+	ActorStatIndex::Bits candidates;
+	bool narrowed = NarrowByIndex(map->GetActorStatIndex(), oC, candidates);
+	std::vector<Actor*> subset;
+	if (narrowed) {
+		map->GetActorStatIndex().Collect(candidates, subset);
+	}
+	int i = narrowed ? int(subset.size()) : map->GetActorCount(true);
 	while (i--) {
-		Actor *ac = map->GetActor(i, true);
+		Actor *ac = narrowed ? subset[i] : map->GetActor(i, true);
 		if (!ac) continue; // is this check really needed?
 		// don't return Sender in IDS targeting!
 		// unless it's pst, which relies on it in 3012cut2-3012cut7.bcs
@@ -695,9 +695,10 @@ Targets *GameScript::LeastDamagedOf(const Scriptable *Sender, Targets *parameter
 Targets *GameScript::Farthest(const Scriptable */*Sender*/, Targets *parameters, int ga_flags)
 {
 	const targettype *t = parameters->GetLastTarget(ST_ACTOR);
+	Scriptable *farthest = t ? t->actor : nullptr;
 	parameters->Clear();
-	if (t) {
-		parameters->AddTarget(t->actor, 0, ga_flags);
+	if (farthest) {
+		parameters->AddTarget(farthest, 0, ga_flags);
 	}
 	return parameters;
 }
@@ -986,7 +987,12 @@ int GameScript::ID_Alignment(const Actor *actor, int parameter)
 
 int GameScript::ID_Allegiance(const Actor *actor, int parameter)
 {
-	int value = actor->GetStat( IE_EA );
+	return MatchAllegiance(actor->GetStat(IE_EA), parameter);
+}
+
+// split out, so the matching can also be done on bare values
+bool GameScript::MatchAllegiance(int value, int parameter)
+{
 	switch (parameter) {
 		case EA_GOODCUTOFF:
 			return value <= EA_GOODCUTOFF;
@@ -0,0 +1,142 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "GameScript/ScriptProfiler.h"
+
+#include "Strings/String.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+ScriptProfiler& ScriptProfiler::Get()
+{
+	static ScriptProfiler profiler;
+	return profiler;
+}
+
+void ScriptProfiler::AddScript(const ResRef& script, const ResRef& area, const Sample& sample)
+{
+	if (!sample.Running()) return;
+
+	clock::duration elapsed = sample.Elapsed();
+	scripts[script].Add(elapsed);
+	areas[area].Add(elapsed);
+}
+
+void ScriptProfiler::AddBlock(const ResRef& script, size_t block, const Sample& sample)
+{
+	if (!sample.Running()) return;
+
+	std::vector<Stats>& scriptBlocks = blocks[script];
+	if (scriptBlocks.size() <= block) {
+		scriptBlocks.resize(block + 1);
+	}
+	scriptBlocks[block].Add(sample.Elapsed());
+}
+
+void ScriptProfiler::AddTrigger(unsigned short triggerID, const Sample& sample)
+{
+	if (!sample.Running() || triggerID >= triggers.size()) return;
+
+	triggers[triggerID].Add(sample.Elapsed());
+}
+
+void ScriptProfiler::AddAction(unsigned short actionID, const Sample& sample)
+{
+	if (!sample.Running() || actionID >= actions.size()) return;
+
+	actions[actionID].Add(sample.Elapsed());
+}
+
+void ScriptProfiler::Reset()
+{
+	scripts.clear();
+	areas.clear();
+	blocks.clear();
+	triggers.fill(Stats());
+	actions.fill(Stats());
+}
+
+struct ReportLine {
+	std::string name;
+	ScriptProfiler::Stats stats;
+};
+
+static void AppendSection(std::string& report, const char* title, std::vector<ReportLine>& lines, size_t count)
+{
+	size_t shown = std::min(count, lines.size());
+	std::partial_sort(lines.begin(), lines.begin() + shown, lines.end(), [](const ReportLine& a, const ReportLine& b) {
+		return a.stats.time > b.stats.time;
+	});
+
+	AppendFormat(report, "{}:\n", title);
+	for (size_t i = 0; i < shown; ++i) {
+		using namespace std::chrono;
+		const ScriptProfiler::Stats& stats = lines[i].stats;
+		int64_t total = duration_cast<microseconds>(stats.time).count();
+		AppendFormat(report, "  {:>10}us {:>9} calls {:>8.2f}us/call  {}\n", total, stats.calls, double(total) / stats.calls, lines[i].name);
+	}
+}
+
+std::string ScriptProfiler::Report(size_t count, const NameLookup& triggerName, const NameLookup& actionName) const
+{
+	std::string report("Script profile (inclusive times):\n");
+	std::vector<ReportLine> lines;
+
+	for (const auto& script : scripts) {
+		lines.push_back({ script.first.c_str(), script.second });
+	}
+	AppendSection(report, "Scripts", lines, count);
+
+	lines.clear();
+	for (const auto& area : areas) {
+		// the game script isn't run by anything in an area
+		lines.push_back({ area.first.IsEmpty() ? "<none>" : area.first.c_str(), area.second });
+	}
+	AppendSection(report, "Areas", lines, count);
+
+	lines.clear();
+	for (const auto& script : blocks) {
+		for (size_t i = 0; i < script.second.size(); ++i) {
+			if (!script.second[i].calls) continue;
+			lines.push_back({ fmt::format("{} block {}", script.first, i), script.second[i] });
+		}
+	}
+	AppendSection(report, "Response blocks", lines, count);
+
+	lines.clear();
+	for (unsigned int i = 0; i < triggers.size(); ++i) {
+		if (!triggers[i].calls) continue;
+		lines.push_back({ fmt::format("{:#x} {}", i, triggerName(i)), triggers[i] });
+	}
+	AppendSection(report, "Triggers", lines, count);
+
+	lines.clear();
+	for (unsigned int i = 0; i < actions.size(); ++i) {
+		if (!actions[i].calls) continue;
+		lines.push_back({ fmt::format("{} {}", i, actionName(i)), actions[i] });
+	}
+	AppendSection(report, "Actions", lines, count);
+
+	return report;
+}
+
+}
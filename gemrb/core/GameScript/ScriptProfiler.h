@@ -0,0 +1,97 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SCRIPTPROFILER_H
+#define SCRIPTPROFILER_H
+
+#include "exports.h"
+
+#include "GameScript/GameScript.h"
+#include "Interface.h"
+#include "Resource.h"
+#include "Strings/StringView.h"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+// Accumulates the time spent in scripts while the script profiling debug
+// mode is on: per script, per response block of a script, per area and per
+// trigger and action id. All times are inclusive, so a script contains its
+// blocks and a block its triggers and actions. When the mode is off, the
+// only cost is the check in the Sample constructor.
+class GEM_EXPORT ScriptProfiler {
+public:
+	using clock = std::chrono::steady_clock;
+
+	struct Stats {
+		clock::duration time {};
+		unsigned long calls = 0;
+
+		void Add(clock::duration elapsed)
+		{
+			time += elapsed;
+			calls++;
+		}
+	};
+
+	// starts timing only if profiling is enabled
+	class Sample {
+		clock::time_point start;
+		bool running;
+	public:
+		Sample() : running(Enabled())
+		{
+			if (running) start = clock::now();
+		}
+		bool Running() const { return running; }
+		clock::duration Elapsed() const { return clock::now() - start; }
+	};
+
+	using NameLookup = std::function<StringView(unsigned int)>;
+
+	static ScriptProfiler& Get();
+	static bool Enabled() { return core->InDebugMode(ID_SCRIPTPROFILE); }
+
+	void AddScript(const ResRef& script, const ResRef& area, const Sample& sample);
+	void AddBlock(const ResRef& script, size_t block, const Sample& sample);
+	void AddTrigger(unsigned short triggerID, const Sample& sample);
+	void AddAction(unsigned short actionID, const Sample& sample);
+
+	bool Empty() const { return scripts.empty(); }
+	void Reset();
+	// the count most expensive entries of every category, by total time
+	std::string Report(size_t count, const NameLookup& triggerName, const NameLookup& actionName) const;
+
+private:
+	ResRefMap<Stats> scripts;
+	ResRefMap<Stats> areas;
+	ResRefMap<std::vector<Stats>> blocks;
+	std::array<Stats, MAX_TRIGGERS> triggers {};
+	std::array<Stats, MAX_ACTIONS> actions {};
+};
+
+}
+
+#endif
@@ -522,7 +522,7 @@ int GameScript::BitCheck(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid && value & parameters->int0Parameter) return 1;
 	return 0;
 }
@@ -531,7 +531,7 @@ int GameScript::BitCheckExact(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
 		ieDword tmp = (ieDword) parameters->int0Parameter ;
 		if ((value & tmp) == tmp) return 1;
@@ -545,7 +545,7 @@ int GameScript::BitGlobal_Trigger(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
 		HandleBitMod(value, parameters->int0Parameter, BitOp(parameters->int1Parameter));
 		if (value!=0) return 1;
@@ -557,10 +557,10 @@ int GameScript::GlobalOrGlobal_Trigger(Scriptable *Sender, const Trigger *parame
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
 		if (value1) return 1;
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters, 1, &valid);
 		if (valid && value2) return 1;
 	}
 	return 0;
@@ -570,9 +570,9 @@ int GameScript::GlobalAndGlobal_Trigger(Scriptable *Sender, const Trigger *param
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid && value1) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters, 1, &valid);
 		if (valid && value2) return 1;
 	}
 	return 0;
@@ -582,9 +582,9 @@ int GameScript::GlobalBAndGlobal_Trigger(Scriptable *Sender, const Trigger *para
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters, 1, &valid);
 		if (valid && (value1 & value2) != 0) return 1;
 	}
 	return 0;
@@ -594,9 +594,9 @@ int GameScript::GlobalBAndGlobalExact(Scriptable *Sender, const Trigger *paramet
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters, 1, &valid);
 		if (valid && (value1 & value2) == value2) return 1;
 	}
 	return 0;
@@ -606,9 +606,9 @@ int GameScript::GlobalBitGlobal_Trigger(Scriptable *Sender, const Trigger *param
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters, 1, &valid);
 		if (valid) {
 			HandleBitMod(value1, value2, BitOp(parameters->int1Parameter));
 			if (value1!=0) return 1;
@@ -630,7 +630,7 @@ int GameScript::Xor(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid && (value ^ parameters->int0Parameter) != 0) return 1;
 	return 0;
 }
@@ -687,7 +687,7 @@ int GameScript::Global(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid && value == parameters->int0Parameter) {
 		return 1;
 	}
@@ -704,7 +704,7 @@ int GameScript::GlobalLT(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid && value < parameters->int0Parameter) return 1;
 	return 0;
 }
@@ -719,7 +719,7 @@ int GameScript::GlobalGT(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid && value > parameters->int0Parameter) return 1;
 	return 0;
 }
@@ -728,9 +728,9 @@ int GameScript::GlobalLTGlobal(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value1 = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
-		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDwordSigned value2 = CheckVariable(Sender, parameters, 1, &valid);
 		if (valid && value1 < value2) return 1;
 	}
 	return 0;
@@ -740,9 +740,9 @@ int GameScript::GlobalGTGlobal(Scriptable *Sender, const Trigger *parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value1 = CheckVariable(Sender, parameters, 0, &valid);
 	if (valid) {
-		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDwordSigned value2 = CheckVariable(Sender, parameters, 1, &valid);
 		if (valid && value1 > value2) return 1;
 	}
 	return 0;
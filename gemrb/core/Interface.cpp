@@ -654,6 +654,21 @@ void Interface::Main()
 			auto lock = winmgr->DrawHUD();
 			video->DrawRect( fpsRgn, ColorBlack );
 			fps->Print(fpsRgn, String(fpsstring), IE_FONT_ALIGN_MIDDLE | IE_FONT_SINGLE_LINE, {ColorWhite, ColorBlack});
+			// the fog debug mode toggles the fog renderer, so both timings fill in
+			if (InDebugMode(ID_FOG)) {
+				const FogRenderer::DrawTimes& fogTimes = fogRenderer->GetDrawTimes();
+				Region fogRgn(fpsRgn.x, fpsRgn.y + fpsRgn.h, 200, fpsRgn.h);
+				String fogString = fmt::format(L"fog {:.3f} ms, per cell {:.3f} ms", fogTimes.alphaMap, fogTimes.perCell);
+				video->DrawRect(fogRgn, ColorBlack);
+				fps->Print(fogRgn, fogString, IE_FONT_ALIGN_MIDDLE | IE_FONT_SINGLE_LINE, {ColorWhite, ColorBlack});
+			}
+			if (InDebugMode(ID_RENDER)) {
+				Video::FrameStats stats = video->GetFrameStats();
+				Region statsRgn(fpsRgn.x, fpsRgn.y + fpsRgn.h * (InDebugMode(ID_FOG) ? 2 : 1), 200, fpsRgn.h);
+				String statsString = fmt::format(L"tex {}, draws {}, breaks {}", stats.textures, stats.drawCalls, stats.batchBreaks);
+				video->DrawRect(statsRgn, ColorBlack);
+				fps->Print(statsRgn, statsString, IE_FONT_ALIGN_MIDDLE | IE_FONT_SINGLE_LINE, {ColorWhite, ColorBlack});
+			}
 		}
 	} while (video->SwapBuffers() == GEM_OK && !(QuitFlag&QF_KILL));
 	QuitGame(0);
@@ -802,6 +817,7 @@ int Interface::Init(const InterfaceConfig* cfg)
 	CONFIG_INT("EnableCheatKeys", EnableCheatKeys);
 	CONFIG_INT("GCDebug", GameControl::DebugFlags = );
 	CONFIG_INT("Height", config.Height =);
+	CONFIG_INT("HierarchicalPathfinding", config.HierarchicalPathfinding =);
 	CONFIG_INT("KeepCache", config.KeepCache =);
 	CONFIG_INT("MaxPartySize", config.MaxPartySize =);
 	config.MaxPartySize = std::min(std::max(1, config.MaxPartySize), 10);
@@ -810,6 +826,7 @@ int Interface::Init(const InterfaceConfig* cfg)
 	CONFIG_INT("MultipleQuickSaves", config.MultipleQuickSaves =);
 	CONFIG_INT("RepeatKeyDelay", Control::ActionRepeatDelay =);
 	CONFIG_INT("SaveAsOriginal", config.SaveAsOriginal =);
+	CONFIG_INT("ScriptBudget", config.ScriptBudget =);
 	CONFIG_INT("SpriteFogOfWar", config.SpriteFoW =);
 	CONFIG_INT("DebugMode", config.debugMode =);
 	int touchInput = -1;
@@ -1066,7 +1083,7 @@ int Interface::Init(const InterfaceConfig* cfg)
 
 	char path[_MAX_PATH];
 	PathJoin(path, config.CachePath, nullptr);
-	if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY)) {
+	if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY, RM_VOLATILE_SOURCE)) {
 		Log(FATAL, "Core", "The cache path couldn't be registered, please check!");
 		return GEM_ERROR;
 	}
@@ -286,7 +286,11 @@ enum DebugModeBits {
 	ID_WINDOWS = 64,
 	ID_FONTS = 128,
 	ID_TEXT = 256,
-	ID_PATHFINDER = 512
+	ID_PATHFINDER = 512,
+	ID_SCRIPTS = 1024,
+	ID_SCRIPTPROFILE = 2048,
+	ID_FOG = 4096,
+	ID_RENDER = 8192
 };
 
 // TODO: there is no reason why this can't be generated directly from
@@ -340,6 +344,8 @@ struct CFGConfigData {
 	int Bpp = 32;
 	bool DrawFPS = false;
 	bool SpriteFoW = false;
+	bool HierarchicalPathfinding = false;
+	int ScriptBudget = 0; // in microseconds
 	int debugMode = 0;
 	bool CheatFlag = false; /** Cheats enabled? */
 	int MaxPartySize = 6;
@@ -61,6 +61,8 @@
 namespace GemRB {
 
 static constexpr unsigned int MAX_CIRCLESIZE = 8;
+// it is only a memo, so just start over once it grows too big
+static constexpr size_t LOS_CACHE_SIZE = 0x10000;
 
 const PixelFormat TileProps::pixelFormat(0, 0, 0, 0,
 										 searchMapShift, materialMapShift,
@@ -422,6 +424,7 @@ ExploredBitmap(FogMapSize(), uint8_t(0x00)), VisibleBitmap(FogMapSize(), uint8_t
 {
 	area = this;
 	MasterArea = core->GetGame()->MasterArea(scriptName);
+	actorGrid.Reset(PropsSize());
 }
 
 Map::~Map(void)
@@ -471,6 +474,19 @@ Map::~Map(void)
 void Map::SetTileMapProps(TileProps props)
 {
 	tileProps = std::move(props);
+	pathClusters.Clear();
+	losCache.clear();
+	actorGrid.Reset(PropsSize());
+	for (Actor* actor : actors) {
+		actorGrid.Insert(actor);
+	}
+}
+
+void Map::SearchMapChanged(const Region& tiles)
+{
+	pathClusters.Invalidate(tiles);
+	losCache.clear();
+	searchMapVersion++;
 }
 	
 const MapReverbProperties& Map::GetReverbProperties() const
@@ -711,6 +727,9 @@ void Map::UpdateScripts()
 	
 	ieDword time = game->Ticks; // make sure everything moves at the same time
 
+	// spread the script evaluations over several ticks if they get too slow
+	scriptScheduler.BeginTick(core->config.ScriptBudget);
+
 	//Run actor scripts (only for 0 priority)
 	size_t q = queue[PR_SCRIPT].size();
 	while (q--) {
@@ -776,6 +795,17 @@ void Map::UpdateScripts()
 		}
 	}
 
+	scriptScheduler.EndTick();
+
+	if (core->InDebugMode(ID_PATHFINDER)) {
+		actorGrid.Check(actors);
+	}
+	if (core->InDebugMode(ID_SCRIPTS) && time % core->Time.ai_update_time == 0) {
+		ScriptScheduler::Stats stats = scriptScheduler.TakeWindow();
+		Log(DEBUG, "Map", "{}: actor scripts took up to {}us per tick, ran {}, deferred {}, worst delay {} ticks",
+			scriptName, stats.scriptTime, stats.ran, stats.deferred, stats.worstDelay);
+	}
+
 	//clean up effects on dead actors too
 	q = queue[PR_DISPLAY].size();
 	while(q--) {
@@ -903,9 +933,20 @@ void Map::DoStepForActor(Actor *actor, ieDword time) const
 
 	if (!(actor->GetBase(IE_STATE_ID)&STATE_CANTMOVE) ) {
 		actor->DoStep(walkScale, time);
+		actorGrid.Update(actor);
 	}
 }
 
+void Map::ActorMoved(const Movable *actor) const
+{
+	actorGrid.Update(actor);
+}
+
+void Map::ActorStatsChanged(const Actor *actor) const
+{
+	actorStatIndex.Update(actor);
+}
+
 void Map::BlockSearchMapFor(const Movable *actor) const
 {
 	auto flag = actor->IsPC() ? PathMapFlags::PC : PathMapFlags::NPC;
@@ -1508,31 +1549,27 @@ void Map::SetDrawingStencilForObject(const void* object, const Region& objectRgn
 	if (behindWall && inFrontOfWall) {
 		// we need a custom stencil if both behind and in front of a wall
 		auto it = objectStencils.find(object);
-		if (it != objectStencils.end()) {
-			// we already made one
-			const auto& pair = it->second;
-			if (pair.second.RectInside(objectRgn)) {
-				// and it is still good
-				stencil = pair.first;
+		if (it != objectStencils.end() && it->second.bounds.RectInside(objectRgn)) {
+			// we already made one and it is still big enough
+			ObjectStencil& cached = it->second;
+			stencil = cached.buffer;
+			stencil->SetOrigin(objectRgn.origin - viewPortOrigin);
+			// the walls only look different if the object moved or a door changed state
+			if (cached.drawn != objectRgn || cached.wallsVersion != wallsVersion) {
+				stencil->Clear();
+				DrawStencil(stencil, objectRgn, walls.first);
+				cached.drawn = objectRgn;
+				cached.wallsVersion = wallsVersion;
 			}
-		}
-		
-		if (stencil == nullptr) {
+		} else {
 			Region stencilRgn = Region(objectRgn.origin - viewPortOrigin, objectRgn.size);
 			if (stencilRgn.size.IsInvalid()) {
 				stencil = wallStencil;
 			} else {
 				stencil = video->CreateBuffer(stencilRgn, Video::BufferFormat::DISPLAY_ALPHA);
 				DrawStencil(stencil, objectRgn, walls.first);
-				objectStencils[object] = std::make_pair(stencil, objectRgn);
+				objectStencils[object] = { stencil, objectRgn, objectRgn, wallsVersion };
 			}
-		} else {
-			// TODO: we only need to do this because a door might have changed state over us
-			// if we could detect that we could avoid doing this expensive operation
-			// we could add another wall flag to mark doors and then we only need to do this if one of the "walls" over us has that flag set
-			stencil->Clear();
-			stencil->SetOrigin(objectRgn.origin - viewPortOrigin);
-			DrawStencil(stencil, objectRgn, walls.first);
 		}
 		
 		debugColor = ColorRed;
@@ -1718,19 +1755,17 @@ void Map::DrawDebugOverlay(const Region &vp, uint32_t dFlags) const
 		// draw also pathfinding waypoints
 		const Actor *act = core->GetFirstSelectedActor();
 		if (!act) return;
-		const PathListNode *path = act->GetPath();
-		if (!path) return;
-		const PathListNode *step = path->Next;
+		const Path& path = act->GetPath();
+		if (path.empty()) return;
 		Color waypoint(0, 64, 128, 128); // darker blue-ish
 		int i = 0;
 		block.w = 8;
 		block.h = 6;
-		while (step) {
+		for (auto step = path.begin() + 1; step != path.end(); ++step) {
 			block.x = (step->point.x+64) - vp.x;
 			block.y = (step->point.y+6) - vp.y;
 			Log(DEBUG, "Map", "Waypoint {} at {}", i, step->point);
 			vid->DrawRect(block, waypoint);
-			step = step->Next;
 			i++;
 		}
 	}
@@ -1878,6 +1913,9 @@ void Map::AddActor(Actor* actor, bool init)
 	actor->Area = scriptName;
 	if (!HasActor(actor)) {
 		actors.push_back( actor );
+		actorGrid.Insert(actor);
+		actorStatIndex.Insert(actor);
+		actorsByGlobalID[actor->GetGlobalID()] = actor;
 	}
 	if (init) {
 		actor->SetMap(this);
@@ -1924,6 +1962,9 @@ void Map::DeleteActor(int i)
 		}
 	}
 	//remove the actor from the area's actor list
+	actorGrid.Remove(actor);
+	actorStatIndex.Remove(actor);
+	actorsByGlobalID.erase(actor->GetGlobalID());
 	actors.erase( actors.begin()+i );
 }
 
@@ -1935,15 +1976,8 @@ Scriptable *Map::GetScriptableByGlobalID(ieDword objectID)
 	if (scr)
 		return scr;
 
-	scr = GetInfoPointByGlobalID(objectID);
-	if (scr)
-		return scr;
-
-	scr = GetContainerByGlobalID(objectID);
-	if (scr)
-		return scr;
-
-	scr = GetDoorByGlobalID(objectID);
+	// infopoints, containers and doors
+	scr = TMap->GetScriptableByGlobalID(objectID);
 	if (scr)
 		return scr;
 
@@ -1957,42 +1991,21 @@ Door *Map::GetDoorByGlobalID(ieDword objectID) const
 {
 	if (!objectID) return NULL;
 
-	int doorCount = 0;
-	while (true) {
-		Door* door = TMap->GetDoor( doorCount++ );
-		if (!door)
-			return NULL;
-		if (door->GetGlobalID() == objectID)
-			return door;
-	}
+	return Scriptable::As<Door>(TMap->GetScriptableByGlobalID(objectID));
 }
 
 Container *Map::GetContainerByGlobalID(ieDword objectID) const
 {
 	if (!objectID) return NULL;
 
-	int containerCount = 0;
-	while (true) {
-		Container* container = TMap->GetContainer( containerCount++ );
-		if (!container)
-			return NULL;
-		if (container->GetGlobalID() == objectID)
-			return container;
-	}
+	return Scriptable::As<Container>(TMap->GetScriptableByGlobalID(objectID));
 }
 
 InfoPoint *Map::GetInfoPointByGlobalID(ieDword objectID) const
 {
 	if (!objectID) return NULL;
 
-	int ipCount = 0;
-	while (true) {
-		InfoPoint* ip = TMap->GetInfoPoint( ipCount++ );
-		if (!ip)
-			return NULL;
-		if (ip->GetGlobalID() == objectID)
-			return ip;
-	}
+	return Scriptable::As<InfoPoint>(TMap->GetScriptableByGlobalID(objectID));
 }
 
 Actor* Map::GetActorByGlobalID(ieDword objectID) const
@@ -2000,12 +2013,11 @@ Actor* Map::GetActorByGlobalID(ieDword objectID) const
 	if (!objectID) {
 		return nullptr;
 	}
-	for (const auto& actor : actors) {
-		if (actor->GetGlobalID()==objectID) {
-			return actor;
-		}
+	auto it = actorsByGlobalID.find(objectID);
+	if (it == actorsByGlobalID.end()) {
+		return nullptr;
 	}
-	return nullptr;
+	return it->second;
 }
 
 /** flags:
@@ -2014,49 +2026,66 @@ Actor* Map::GetActorByGlobalID(ieDword objectID) const
  GA_POINT     64  - not actor specific
  GA_NO_HIDDEN 128 - hidden actors don't play
 */
+// larger radii just mean the whole map
+constexpr unsigned int MAX_QUERY_RADIUS = 0xffff;
+
+// the grid returns the actors in no particular order, but the first match
+// in the actor list has to win, so we keep the one added earliest
 Actor* Map::GetActor(const Point &p, int flags, const Movable *checker) const
 {
-	for (auto actor : actors) {
-		if (!actor->IsOver( p ))
-			continue;
-		if (!actor->ValidTarget(flags, checker) ) {
-			continue;
-		}
-		return actor;
-	}
-	return NULL;
+	const ActorGrid::Entry* found = nullptr;
+	actorGrid.ForEachNear(Region(p, Size()), [&](const ActorGrid::Entry& entry) {
+		if (found && found->seq < entry.seq) return;
+		if (!entry.actor->IsOver(p)) return;
+		if (!entry.actor->ValidTarget(flags, checker)) return;
+		found = &entry;
+	});
+	return found ? found->actor : nullptr;
 }
 
 Actor* Map::GetActorInRadius(const Point &p, int flags, unsigned int radius) const
 {
-	for (auto actor : actors) {
-		if (PersonalDistance( p, actor ) > radius)
-			continue;
-		if (!actor->ValidTarget(flags) ) {
-			continue;
-		}
-		return actor;
-	}
-	return NULL;
+	const ActorGrid::Entry* found = nullptr;
+	int range = int(std::min(radius, MAX_QUERY_RADIUS));
+	actorGrid.ForEachNear(Region(p.x - range, p.y - range, 2 * range, 2 * range), [&](const ActorGrid::Entry& entry) {
+		if (found && found->seq < entry.seq) return;
+		if (PersonalDistance(p, entry.actor) > radius) return;
+		if (!entry.actor->ValidTarget(flags)) return;
+		found = &entry;
+	});
+	return found ? found->actor : nullptr;
 }
 
 std::vector<Actor *> Map::GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, const Scriptable *see) const
 {
-	std::vector<Actor *> neighbours;
-	for (auto actor : actors) {
+	std::vector<ActorGrid::Entry> found;
+	// the radius is in feet, which is at most 16 pixels each
+	int range = int(std::min(radius, MAX_QUERY_RADIUS)) * 16;
+	actorGrid.ForEachNear(Region(p.x - range, p.y - range, 2 * range, 2 * range), [&](const ActorGrid::Entry& entry) {
+		Actor* actor = entry.actor;
 		if (!WithinRange(actor, p, radius)) {
-			continue;
+			return;
 		}
 		if (!actor->ValidTarget(flags, see) ) {
-			continue;
+			return;
 		}
 		if (!(flags&GA_NO_LOS)) {
 			//line of sight visibility
 			if (!IsVisibleLOS(actor->Pos, p)) {
-				continue;
+				return;
 			}
 		}
-		neighbours.emplace_back(actor);
+		found.push_back(entry);
+	});
+
+	// keep the order of the actor list
+	std::sort(found.begin(), found.end(), [](const ActorGrid::Entry& a, const ActorGrid::Entry& b) {
+		return a.seq < b.seq;
+	});
+	std::vector<Actor *> neighbours;
+	neighbours.reserve(found.size());
+	for (const ActorGrid::Entry& entry : found) {
+		neighbours.push_back(entry.actor);
 	}
 	return neighbours;
 }
@@ -2097,6 +2126,7 @@ void Map::JumpActors(bool jump) const
 			if (jump && !(actor->GetStat(IE_DONOTJUMP) & DNJ_BIRD)) {
 				ClearSearchMapFor(actor);
 				AdjustPositionNavmap(actor->Pos);
+				actorGrid.Update(actor);
 				actor->ImpedeBumping();
 			}
 			actor->SetBase(IE_DONOTJUMP,0);
@@ -2166,6 +2196,7 @@ void Map::PurgeArea(bool items)
 		if (!actor->ValidTarget(GA_NO_DEAD|GA_NO_UNSCHEDULED|GA_NO_ALLY|GA_NO_ENEMY)) continue;
 		if (!actor->HomeLocation.IsZero() && !actor->HomeLocation.IsInvalid() && actor->Pos != actor->HomeLocation) {
 			actor->Pos = actor->HomeLocation;
+			actorGrid.Update(actor);
 		}
 	}
 }
@@ -2285,18 +2316,27 @@ Actor *Map::GetActorByScriptName(const ieVariable& name) const
 
 std::vector<Actor*> Map::GetActorsInRect(const Region& rgn, int excludeFlags) const
 {
-	std::vector<Actor*> actorlist;
-	actorlist.reserve(actors.size());
-	for (auto actor : actors) {
+	std::vector<ActorGrid::Entry> found;
+	actorGrid.ForEachNear(rgn, [&](const ActorGrid::Entry& entry) {
+		const Actor* actor = entry.actor;
 		if (!actor->ValidTarget(excludeFlags))
-			continue;
+			return;
 		if (!rgn.PointInside(actor->Pos)
 			&& !actor->IsOver(rgn.origin)) // imagine drawing a tiny box inside the circle, but not over the center
-			continue;
+			return;
+
+		found.push_back(entry);
+	});
 
-		actorlist.push_back(actor);
+	// keep the order of the actor list
+	std::sort(found.begin(), found.end(), [](const ActorGrid::Entry& a, const ActorGrid::Entry& b) {
+		return a.seq < b.seq;
+	});
+	std::vector<Actor*> actorlist;
+	actorlist.reserve(found.size());
+	for (const ActorGrid::Entry& entry : found) {
+		actorlist.push_back(entry.actor);
 	}
-	
 	return actorlist;
 }
 
@@ -2437,22 +2477,62 @@ PathMapFlags Map::GetBlockedInRadiusTile(const Point &tp, uint16_t size, const b
 	return ret;
 }
 
-PathMapFlags Map::GetBlockedInLine(const Point &s, const Point &d, bool stopOnImpassable, const Actor *caller) const
+// Visits the searchmap cells crossed by the segment from s to d (navmap points) in order,
+// stopping early if visit returns false. This is an integer DDA (Amanatides & Woo, 1987):
+// the distances to the next cell border on each axis are compared by cross multiplication,
+// so every crossed cell is visited exactly once and no floating point is needed
+template <typename F>
+static void MarchLine(const NavmapPoint& s, const NavmapPoint& d, F&& visit)
+{
+	SearchmapPoint cell = Map::ConvertCoordToTile(s);
+	const SearchmapPoint end = Map::ConvertCoordToTile(d);
+	const int stepX = d.x > s.x ? 1 : -1;
+	const int stepY = d.y > s.y ? 1 : -1;
+	const int64_t adx = std::abs(d.x - s.x);
+	const int64_t ady = std::abs(d.y - s.y);
+	int64_t nextX = stepX > 0 ? (cell.x + 1) * 16 - s.x : s.x - cell.x * 16;
+	int64_t nextY = stepY > 0 ? (cell.y + 1) * 12 - s.y : s.y - cell.y * 12;
+
+	if (!visit(cell)) return;
+	int steps = std::abs(end.x - cell.x) + std::abs(end.y - cell.y);
+	while (steps--) {
+		bool moveX;
+		if (cell.x == end.x) {
+			moveX = false;
+		} else if (cell.y == end.y) {
+			moveX = true;
+		} else {
+			// nextX / adx <= nextY / ady
+			moveX = nextX * ady <= nextY * adx;
+		}
+		if (moveX) {
+			cell.x += stepX;
+			nextX += 16;
+		} else {
+			cell.y += stepY;
+			nextY += 12;
+		}
+		if (!visit(cell)) return;
+	}
+}
+
+PathMapFlags Map::GetBlockedInLine(const Point &s, const Point &d, bool stopOnImpassable) const
 {
 	PathMapFlags ret = PathMapFlags::IMPASSABLE;
-	Point p = s;
-	while (p != d) {
-		double dx = d.x - p.x;
-		double dy = d.y - p.y;
-		double factor = caller && caller->GetSpeed() ? double(gamedata->GetStepTime()) / double(caller->GetSpeed()) : 1;
-		NormalizeDeltas(dx, dy, factor);
-		p.x += dx;
-		p.y += dy;
-		PathMapFlags blockStatus = GetBlocked(p);
+	if (s == d) return ret;
+
+	bool impassable = false;
+	MarchLine(s, d, [&](const SearchmapPoint& cell) {
+		PathMapFlags blockStatus = GetBlockedTile(cell);
 		if (stopOnImpassable && blockStatus == PathMapFlags::IMPASSABLE) {
-			return PathMapFlags::IMPASSABLE;
+			impassable = true;
+			return false;
 		}
 		ret |= blockStatus;
+		return true;
+	});
+	if (impassable) {
+		return PathMapFlags::IMPASSABLE;
 	}
 	if (bool(ret & (PathMapFlags::DOOR_IMPASSABLE|PathMapFlags::ACTOR|PathMapFlags::SIDEWALL))) {
 		ret &= ~PathMapFlags::PASSABLE;
@@ -2465,26 +2545,52 @@ PathMapFlags Map::GetBlockedInLine(const Point &s, const Point &d, bool stopOnIm
 }
 
 // PathMapFlags::SIDEWALL obstructs LOS, while PathMapFlags::IMPASSABLE doesn't
-bool Map::IsVisibleLOS(const Point &s, const Point &d, const Actor *caller) const
+// Sight only depends on the area and door bits of the searchmap, so the results
+// are remembered per pair of cells (traced between their centers) until a door changes
+bool Map::IsVisibleLOS(const Point &s, const Point &d, const Actor* /*caller*/) const
 {
-	PathMapFlags ret = GetBlockedInLine(s, d, false, caller);
-	return !bool(ret & PathMapFlags::SIDEWALL);
+	if (s == d) return true;
+
+	SearchmapPoint from = ConvertCoordToTile(s);
+	SearchmapPoint to = ConvertCoordToTile(d);
+	const Size& mapSize = PropsSize();
+	if (!mapSize.PointInside(from) || !mapSize.PointInside(to)) {
+		return !bool(GetBlockedInLine(s, d, false) & PathMapFlags::SIDEWALL);
+	}
+
+	uint64_t key = (uint64_t(from.y * mapSize.w + from.x) << 32) | uint32_t(to.y * mapSize.w + to.x);
+	auto it = losCache.find(key);
+	if (it != losCache.end()) {
+		return it->second;
+	}
+
+	const Point center(8, 6);
+	bool visible = true;
+	MarchLine(ConvertCoordFromTile(from) + center, ConvertCoordFromTile(to) + center, [&](const SearchmapPoint& cell) {
+		visible = !bool(GetBlockedTile(cell) & PathMapFlags::SIDEWALL);
+		return visible;
+	});
+
+	if (losCache.size() >= LOS_CACHE_SIZE) {
+		losCache.clear();
+	}
+	losCache.emplace(key, visible);
+	return visible;
 }
 
 // Used by the pathfinder, so PathMapFlags::IMPASSABLE obstructs walkability
-bool Map::IsWalkableTo(const Point &s, const Point &d, bool actorsAreBlocking, const Actor *caller) const
+bool Map::IsWalkableTo(const Point &s, const Point &d, bool actorsAreBlocking, const Actor* /*caller*/) const
 {
-	PathMapFlags ret = GetBlockedInLine(s, d, true, caller);
+	PathMapFlags ret = GetBlockedInLine(s, d, true);
 	PathMapFlags mask = PathMapFlags::PASSABLE | PathMapFlags::TRAVEL | (actorsAreBlocking ? PathMapFlags::UNMARKED : PathMapFlags::ACTOR);
 	return bool(ret & mask);
 }
 
+// the size of the map space chunks the wall stencil is cached in
+static constexpr int STENCIL_TILE_SIZE = 256;
+
 void Map::RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls)
 {
-	// FIXME: how do we know if a door changed state?
-	// we need to redraw the stencil when that happens
-	// see TODO in Map::SetDrawingStencilForScriptable for another example of something that could use this
-
 	if (stencilViewport == vp) {
 		assert(wallStencil);
 		return;
@@ -2492,17 +2598,81 @@ void Map::RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls)
 
 	stencilViewport = vp;
 
-	if (wallStencil == NULL) {
+	Video* video = core->GetVideoDriver();
+	if (wallStencil == NULL || wallStencil->Size() != vp.size) {
 		// FIXME: this should be forced 8bit*4 color format
 		// but currently that is forcing some performance killing conversion issues on some platforms
 		// for now things will break if we use 16 bit color settings
-		Video* video = core->GetVideoDriver();
 		wallStencil = video->CreateBuffer(Region(Point(), vp.size), Video::BufferFormat::DISPLAY_ALPHA);
 	}
 
 	wallStencil->Clear();
 
-	DrawStencil(wallStencil, vp, walls);
+	if (!video->CanCopyVideoBuffers()) {
+		DrawStencil(wallStencil, vp, walls);
+		return;
+	}
+
+	// assemble the screen stencil from the map space tiles, so scrolling
+	// only needs to rasterize the walls of the tiles that came into view
+	int firstColumn = std::max(vp.x, 0) / STENCIL_TILE_SIZE;
+	int firstRow = std::max(vp.y, 0) / STENCIL_TILE_SIZE;
+	int lastColumn = std::max(vp.x + vp.w - 1, 0) / STENCIL_TILE_SIZE;
+	int lastRow = std::max(vp.y + vp.h - 1, 0) / STENCIL_TILE_SIZE;
+
+	// drop the tiles that scrolled well out of view
+	for (auto it = stencilTiles.begin(); it != stencilTiles.end();) {
+		int column = it->first & 0xffff;
+		int row = it->first >> 16;
+		if (column < firstColumn - 1 || column > lastColumn + 1 || row < firstRow - 1 || row > lastRow + 1) {
+			it = stencilTiles.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	video->PushDrawingBuffer(wallStencil);
+	for (int row = firstRow; row <= lastRow; ++row) {
+		for (int column = firstColumn; column <= lastColumn; ++column) {
+			const VideoBufferPtr& tile = StencilTileAt(column, row);
+			video->BlitVideoBuffer(tile, Point(column * STENCIL_TILE_SIZE, row * STENCIL_TILE_SIZE) - vp.origin, BlitFlags::NONE);
+		}
+	}
+	video->PopDrawingBuffer();
+}
+
+const VideoBufferPtr& Map::StencilTileAt(int column, int row)
+{
+	StencilTile& tile = stencilTiles[uint32_t(row) << 16 | uint32_t(column)];
+	if (!tile.buffer) {
+		Video* video = core->GetVideoDriver();
+		tile.buffer = video->CreateBuffer(Region(0, 0, STENCIL_TILE_SIZE, STENCIL_TILE_SIZE), Video::BufferFormat::DISPLAY_ALPHA);
+		tile.dirty = true;
+	}
+
+	if (tile.dirty) {
+		Region tileRgn(Point(column * STENCIL_TILE_SIZE, row * STENCIL_TILE_SIZE), Size(STENCIL_TILE_SIZE, STENCIL_TILE_SIZE));
+		tile.buffer->Clear();
+		DrawStencil(tile.buffer, tileRgn, WallsIntersectingRegion(tileRgn, false).first);
+		tile.dirty = false;
+	}
+	return tile.buffer;
+}
+
+void Map::WallsChanged(const Region& mapRgn)
+{
+	wallsVersion++;
+	// force the screen stencil to be reassembled
+	stencilViewport = Region();
+
+	for (auto& tile : stencilTiles) {
+		int column = tile.first & 0xffff;
+		int row = tile.first >> 16;
+		Region tileRgn(Point(column * STENCIL_TILE_SIZE, row * STENCIL_TILE_SIZE), Size(STENCIL_TILE_SIZE, STENCIL_TILE_SIZE));
+		if (tileRgn.IntersectsRegion(mapRgn)) {
+			tile.second.dirty = true;
+		}
+	}
 }
 
 void Map::DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const
@@ -2736,6 +2906,9 @@ void Map::RemoveActor(Actor* actor)
 			ClearSearchMapFor(actor);
 			actor->SetMap(NULL);
 			actor->Area.Reset();
+			actorGrid.Remove(actor);
+			actorStatIndex.Remove(actor);
+			actorsByGlobalID.erase(actor->GetGlobalID());
 			actors.erase( actors.begin()+i );
 			return;
 		}
@@ -3227,11 +3400,15 @@ void Map::ExploreTile(const Point &p, bool fogOnly)
 	}
 }
 
-void Map::ExploreMapChunk(const Point &Pos, int range, int los)
+// collects the fog cells seen from Pos; the visible ones are explored too
+void Map::SweepVisibility(const Point& Pos, int range, int los, std::vector<int>& visible, std::vector<int>& exploredOnly) const
 {
 	Point Tile;
 	const Explore& explore = Explore::Get();
+	const Size fogSize = FogMapSize();
 
+	visible.clear();
+	exploredOnly.clear();
 	if (range > explore.MaxVisibility) {
 		range = explore.MaxVisibility;
 	}
@@ -3265,37 +3442,134 @@ void Map::ExploreMapChunk(const Point &Pos, int range, int los)
 					if (!Pass) break;
 				}
 			}
-			ExploreTile(Tile, fogOnly);
+
+			Point fogP = ConvertPointToFog(Tile);
+			if (!fogSize.PointInside(fogP)) continue;
+			int cell = fogP.y * fogSize.w + fogP.x;
+			if (fogOnly) {
+				exploredOnly.push_back(cell);
+			} else {
+				visible.push_back(cell);
+			}
 		}
 	}
+
+	// neighbouring rays cross the same cells a lot
+	for (std::vector<int>* cells : { &visible, &exploredOnly }) {
+		std::sort(cells->begin(), cells->end());
+		cells->erase(std::unique(cells->begin(), cells->end()), cells->end());
+	}
+}
+
+static void ApplyVision(const std::vector<int>& visible, const std::vector<int>& exploredOnly, Bitmap& explored, Bitmap& visibleBits)
+{
+	for (int cell : visible) {
+		explored[cell] = true;
+		visibleBits[cell] = true;
+	}
+	for (int cell : exploredOnly) {
+		explored[cell] = true;
+	}
+}
+
+void Map::ExploreMapChunk(const Point &Pos, int range, int los)
+{
+	static std::vector<int> visible;
+	static std::vector<int> exploredOnly;
+
+	SweepVisibility(Pos, range, los, visible, exploredOnly);
+	ApplyVision(visible, exploredOnly, ExploredBitmap, VisibleBitmap);
+}
+
+// the vision range an explore actor sees with, or 0 if it can't see
+static int GetExploreRange(const Actor* actor)
+{
+	if (!actor->Modified[IE_EXPLORE]) return 0;
+
+	int state = actor->Modified[IE_STATE_ID];
+	if (state & STATE_CANTSEE) return 0;
+
+	int vis2 = actor->Modified[IE_VISUALRANGE];
+	if ((state&STATE_BLIND) || (vis2<2)) vis2=2; //can see only themselves
+	return vis2 + actor->GetAnims()->GetCircleSize();
 }
 
 void Map::UpdateFog()
 {
 	VisibleBitmap.fill(0);
-	
+
+	std::unique_ptr<Bitmap> oldExplored;
+	if (core->InDebugMode(ID_FOG)) {
+		oldExplored = make_unique<Bitmap>(ExploredBitmap);
+	}
+
+	fogUpdates++;
 	std::set<Spawn*> potentialSpawns;
 	for (const auto actor : actors) {
-		if (!actor->Modified[IE_EXPLORE]) continue;
+		int range = GetExploreRange(actor);
+		if (!range) continue;
 
-		int state = actor->Modified[IE_STATE_ID];
-		if (state & STATE_CANTSEE) continue;
-		
-		int vis2 = actor->Modified[IE_VISUALRANGE];
-		if ((state&STATE_BLIND) || (vis2<2)) vis2=2; //can see only themselves
-		ExploreMapChunk (actor->Pos, vis2+actor->GetAnims()->GetCircleSize(), 1);
-		
-		Spawn *sp = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
-		if (sp) {
-			potentialSpawns.insert(sp);
+		// only redo the sweep if the actor, its sight or the doors changed
+		VisionStamp& stamp = visionStamps[actor->GetGlobalID()];
+		if (stamp.lastUpdate == 0 || stamp.pos != actor->Pos || stamp.range != range || stamp.searchMapVersion != searchMapVersion) {
+			SweepVisibility(actor->Pos, range, 1, stamp.visible, stamp.exploredOnly);
+			stamp.range = range;
+			stamp.searchMapVersion = searchMapVersion;
+		}
+		if (stamp.lastUpdate == 0 || stamp.pos != actor->Pos || stamp.spawnCount != spawns.size()) {
+			stamp.spawn = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
+			stamp.spawnCount = spawns.size();
+		}
+		stamp.pos = actor->Pos;
+		stamp.lastUpdate = fogUpdates;
+
+		ApplyVision(stamp.visible, stamp.exploredOnly, ExploredBitmap, VisibleBitmap);
+		if (stamp.spawn) {
+			potentialSpawns.insert(stamp.spawn);
 		}
 	}
-	
+
+	// drop the actors that left, stopped exploring or went blind
+	for (auto it = visionStamps.begin(); it != visionStamps.end();) {
+		if (it->second.lastUpdate != fogUpdates) {
+			it = visionStamps.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	if (oldExplored) {
+		ValidateFog(*oldExplored);
+	}
+
 	for (Spawn* spawn : potentialSpawns) {
 		TriggerSpawn(spawn);
 	}
 }
 
+// redoes every sweep from scratch and compares it to the composed stamps
+void Map::ValidateFog(const Bitmap& oldExplored) const
+{
+	Bitmap explored(oldExplored);
+	Bitmap visible(FogMapSize(), uint8_t(0x00));
+	std::vector<int> visibleCells;
+	std::vector<int> exploredCells;
+	for (const auto actor : actors) {
+		int range = GetExploreRange(actor);
+		if (!range) continue;
+
+		SweepVisibility(actor->Pos, range, 1, visibleCells, exploredCells);
+		ApplyVision(visibleCells, exploredCells, explored, visible);
+	}
+
+	if (!std::equal(visible.begin(), visible.end(), VisibleBitmap.begin())) {
+		Log(ERROR, "Map", "Cached fog of war visibility differs from a full update in {}!", scriptName);
+	}
+	if (!std::equal(explored.begin(), explored.end(), ExploredBitmap.begin())) {
+		Log(ERROR, "Map", "Cached fog of war exploration differs from a full update in {}!", scriptName);
+	}
+}
+
 Spawn* Map::GetSpawn(const ieVariable& Name) const
 {
 	for (auto spawn : spawns) {
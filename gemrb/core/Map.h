@@ -24,12 +24,16 @@
 #include "exports.h"
 #include "globals.h"
 
+#include "ActorGrid.h"
+#include "ActorStatIndex.h"
 #include "Bitmap.h"
 #include "FogRenderer.h"
 #include "Interface.h"
 #include "MapReverb.h"
 #include "Scriptable/Scriptable.h"
+#include "PathClusterGraph.h"
 #include "PathFinder.h"
+#include "ScriptScheduler.h"
 #include "WorldMap.h"
 
 #include <algorithm>
@@ -428,7 +432,45 @@ private:
 	VideoBufferPtr wallStencil = nullptr;
 	Region stencilViewport;
 
-	std::unordered_map<const void*, std::pair<VideoBufferPtr, Region>> objectStencils;
+	// the wall stencil pre-rasterized in map space, see RedrawScreenStencil
+	struct StencilTile {
+		VideoBufferPtr buffer;
+		bool dirty = true;
+	};
+	std::unordered_map<uint32_t, StencilTile> stencilTiles; // keyed by row << 16 | column
+	unsigned int wallsVersion = 0; // bumped by WallsChanged
+
+	struct ObjectStencil {
+		VideoBufferPtr buffer;
+		Region bounds; // the buffer covers this map region
+		Region drawn; // the object region the walls were last drawn for
+		unsigned int wallsVersion;
+	};
+	std::unordered_map<const void*, ObjectStencil> objectStencils;
+
+	mutable PathFinderScratch pathScratch;
+	mutable PathClusterGraph pathClusters;
+	mutable ActorGrid actorGrid;
+	mutable ActorStatIndex actorStatIndex;
+	std::unordered_map<ieDword, Actor*> actorsByGlobalID;
+	mutable std::unordered_map<uint64_t, bool> losCache;
+	ScriptScheduler scriptScheduler;
+
+	// the fog cells an explore actor uncovers from where it stands, so
+	// UpdateFog only has to redo the sweep once something relevant changed
+	struct VisionStamp {
+		Point pos;
+		int range = 0;
+		unsigned int searchMapVersion = 0;
+		size_t spawnCount = 0;
+		Spawn* spawn = nullptr; // in SPAWN_RANGE of pos
+		unsigned int lastUpdate = 0;
+		std::vector<int> visible; // fog cell indices, explored too
+		std::vector<int> exploredOnly; // seen through transparent doors
+	};
+	std::unordered_map<ieDword, VisionStamp> visionStamps; // by global ID
+	unsigned int fogUpdates = 0;
+	unsigned int searchMapVersion = 0; // bumped on every searchmap change
 
 	class MapReverb {
 	public:
@@ -475,6 +517,10 @@ public:
 	bool ChangeMap(bool day_or_night);
 	void SeeSpellCast(Scriptable *caster, ieDword spell) const;
 	void SetTileMapProps(TileProps props);
+	/* the area or door bits of these searchmap cells changed, drops what depends on them */
+	void SearchMapChanged(const Region& tiles);
+	/* walls inside this map region were enabled or disabled, their stencils need redrawing */
+	void WallsChanged(const Region& mapRgn);
 	void AutoLockDoors() const;
 	void UpdateScripts();
 	ResRef ResolveTerrainSound(const ResRef &sound, const Point &pos) const;
@@ -607,8 +653,18 @@ public:
 	void ExploreTile(const Point&, bool fogOnly = false);
 	/* explore map from given point in map coordinates */
 	void ExploreMapChunk(const Point &Pos, int range, int los);
+private:
+	void SweepVisibility(const Point& Pos, int range, int los, std::vector<int>& visible, std::vector<int>& exploredOnly) const;
+	void ValidateFog(const Bitmap& oldExplored) const;
+public:
 	void BlockSearchMapFor(const Movable *actor) const;
 	void ClearSearchMapFor(const Movable *actor) const;
+	/* has to be called whenever an actor changes its position */
+	void ActorMoved(const Movable *actor) const;
+	/* has to be called when the stats used for IDS matching may have changed */
+	void ActorStatsChanged(const Actor *actor) const;
+	const ActorStatIndex& GetActorStatIndex() const { return actorStatIndex; }
+	ScriptScheduler& GetScriptScheduler() { return scriptScheduler; }
 	/* update VisibleBitmap by resolving vision of all explore actors */
 	void UpdateFog();
 	//PathFinder
@@ -616,20 +672,20 @@ public:
 	void AdjustPosition(Point &goal, int radiusx = 0, int radiusy = 0, int size = -1) const;
 	void AdjustPositionNavmap(Point &goal, int radiusx = 0, int radiusy = 0) const;
 	/* Finds the path which leads the farthest from d */
-	PathListNode* RunAway(const Point &s, const Point &d, unsigned int size, int maxPathLength, bool backAway, const Actor *caller) const;
-	PathListNode* RandomWalk(const Point &s, int size, int radius, const Actor *caller) const;
+	bool RunAway(Path& path, const Point &s, const Point &d, unsigned int size, int maxPathLength, bool backAway, const Actor *caller) const;
+	bool RandomWalk(Path& path, const Point &s, int size, int radius, const Actor *caller) const;
 	/* Returns true if there is no path to d */
 	bool TargetUnreachable(const Point &s, const Point &d, unsigned int size, bool actorsAreBlocking = false) const;
 	/* returns true if there is enemy visible */
 	bool AnyPCSeesEnemy() const;
 	/* Finds straight path from s, length l and orientation o, f=1 passes wall, f=2 rebounds from wall*/
 	PathListNode* GetLine(const Point &start, const Point &dest, int flags) const;
-	PathListNode* GetLine(const Point &start, int steps, orient_t orient) const;
+	PathNode GetLine(const Point &start, int steps, orient_t orient) const;
 	PathListNode* GetLine(const Point &start, int Steps, orient_t Orientation, int flags) const;
 	PathListNode* GetLine(const Point &start, const Point &dest, int speed, orient_t Orientation, int flags) const;
 	Path GetLinePath(const Point &start, const Point &dest, int speed, orient_t Orientation, int flags) const;
-	/* Finds the path which leads to near d */
-	PathListNode* FindPath(const Point &s, const Point &d, unsigned int size, unsigned int minDistance = 0, int flags = PF_SIGHT, const Actor *caller = NULL) const;
+	/* Finds the path which leads to near d, fills path (without the starting point), returns false if there is none */
+	bool FindPath(Path& path, const Point &s, const Point &d, unsigned int size, unsigned int minDistance = 0, int flags = PF_SIGHT, const Actor *caller = NULL) const;
 
 	bool IsVisible(const Point &p) const;
 	bool IsExplored(const Point &p) const;
@@ -694,6 +750,7 @@ private:
 	Container *GetNextPile (int &index) const;
 
 	void RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls);
+	const VideoBufferPtr& StencilTileAt(int column, int row);
 	void DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const;
 	WallPolygonSet WallsIntersectingRegion(Region, bool includeDisabled = false, const Point* loc = nullptr) const;
 
@@ -721,7 +778,9 @@ private:
 	bool AdjustPositionY(Point &goal, int radiusx, int radiusy, int size = -1) const;
 	
 	void UpdateSpawns() const;
-	PathMapFlags GetBlockedInLine(const Point &s, const Point &d, bool stopOnImpassable, const Actor *caller = NULL) const;
+	PathMapFlags GetBlockedInLine(const Point &s, const Point &d, bool stopOnImpassable) const;
+	// the search part of FindPath, optionally restricted to the corridor of the cluster graph
+	bool SearchPath(Path& path, const NavmapPoint& nmptSource, NavmapPoint nmptDest, const Point& d, unsigned int size, unsigned int minDistance, int flags, const Actor* caller, bool inCorridor) const;
 	void AddProjectile(Projectile* pro);
 	
 	// same as GetBlocked, but in TileCoords
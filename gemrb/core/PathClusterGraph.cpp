@@ -0,0 +1,347 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "PathClusterGraph.h"
+
+#include "Map.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace GemRB {
+
+constexpr int PathClusterGraph::ClusterSize;
+constexpr unsigned short PathClusterGraph::Unreachable;
+
+// border runs at least this long get an entrance at both ends instead of one in the middle
+constexpr int LONG_RUN = 6;
+constexpr size_t NO_NODE = std::numeric_limits<size_t>::max();
+
+// actors are ignored on purpose, they move and the full search deals with them
+static bool CellWalkable(const TileProps& props, const SearchmapPoint& p)
+{
+	PathMapFlags flags = props.QuerySearchMap(p);
+	if (bool(flags & PathMapFlags::DOOR_IMPASSABLE)) return false;
+	return bool(flags & (PathMapFlags::PASSABLE | PathMapFlags::TRAVEL));
+}
+
+void PathClusterGraph::Clear()
+{
+	mapSize = Size();
+	gridSize = Size();
+	clusters.clear();
+	corridor.clear();
+	anyDirty = true;
+}
+
+void PathClusterGraph::Invalidate(const Region& tiles)
+{
+	if (clusters.empty()) return;
+
+	// a change on a border row also moves the entrances of the neighbour
+	int x1 = std::max(0, (tiles.x - 1) / ClusterSize);
+	int y1 = std::max(0, (tiles.y - 1) / ClusterSize);
+	int x2 = std::min(gridSize.w - 1, (tiles.x + tiles.w) / ClusterSize);
+	int y2 = std::min(gridSize.h - 1, (tiles.y + tiles.h) / ClusterSize);
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			clusters[y * gridSize.w + x].dirty = true;
+			anyDirty = true;
+		}
+	}
+}
+
+void PathClusterGraph::Update(const TileProps& props)
+{
+	const Size& size = props.GetSize();
+	if (size != mapSize) {
+		mapSize = size;
+		gridSize.w = (size.w + ClusterSize - 1) / ClusterSize;
+		gridSize.h = (size.h + ClusterSize - 1) / ClusterSize;
+		clusters.clear();
+		clusters.resize(gridSize.Area());
+		for (int y = 0; y < gridSize.h; ++y) {
+			for (int x = 0; x < gridSize.w; ++x) {
+				Region& bounds = clusters[y * gridSize.w + x].bounds;
+				bounds.x = x * ClusterSize;
+				bounds.y = y * ClusterSize;
+				bounds.w = std::min(ClusterSize, size.w - bounds.x);
+				bounds.h = std::min(ClusterSize, size.h - bounds.y);
+			}
+		}
+		anyDirty = true;
+	}
+	if (!anyDirty) return;
+
+	for (Cluster& cluster : clusters) {
+		if (cluster.dirty) {
+			BuildCluster(props, cluster);
+		}
+	}
+	anyDirty = false;
+}
+
+bool PathClusterGraph::IsWorthUsing(const SearchmapPoint& s, const SearchmapPoint& d) const
+{
+	int dx = std::abs(s.x / ClusterSize - d.x / ClusterSize);
+	int dy = std::abs(s.y / ClusterSize - d.y / ClusterSize);
+	return std::max(dx, dy) >= 2;
+}
+
+int PathClusterGraph::ClusterIndex(const SearchmapPoint& p) const
+{
+	if (!mapSize.PointInside(p)) return -1;
+	return (p.y / ClusterSize) * gridSize.w + p.x / ClusterSize;
+}
+
+void PathClusterGraph::ScanBorder(const TileProps& props, SearchmapPoint cell, const Point& step, const Point& acrossOffset, int length, std::vector<Entrance>& entrances) const
+{
+	// both clusters sharing a border scan it in the same order, so they agree on the entrances
+	auto addEntrance = [&](int i) {
+		SearchmapPoint p(cell.x + i * step.x, cell.y + i * step.y);
+		entrances.push_back({ p, p + acrossOffset });
+	};
+
+	int runStart = -1;
+	for (int i = 0; i <= length; ++i) {
+		bool open = false;
+		if (i < length) {
+			SearchmapPoint p(cell.x + i * step.x, cell.y + i * step.y);
+			open = CellWalkable(props, p) && CellWalkable(props, p + acrossOffset);
+		}
+		if (open) {
+			if (runStart < 0) runStart = i;
+			continue;
+		}
+		if (runStart < 0) continue;
+
+		int runEnd = i - 1;
+		if (runEnd - runStart + 1 >= LONG_RUN) {
+			addEntrance(runStart);
+			addEntrance(runEnd);
+		} else {
+			addEntrance((runStart + runEnd) / 2);
+		}
+		runStart = -1;
+	}
+}
+
+// breadth first flood inside the cluster bounds, bfsDist is indexed by the local cell
+void PathClusterGraph::Flood(const TileProps& props, const Region& bounds, const SearchmapPoint& from)
+{
+	static const Point steps[] = { Point(1, 0), Point(0, 1), Point(-1, 0), Point(0, -1) };
+
+	bfsDist.assign(ClusterSize * ClusterSize, Unreachable);
+	bfsQueue.clear();
+	if (!bounds.PointInside(from)) return;
+
+	// the origin is seeded even if it is blocked, so blocked endpoints can still be connected
+	bfsDist[(from.y - bounds.y) * ClusterSize + from.x - bounds.x] = 0;
+	bfsQueue.push_back(from);
+	for (size_t head = 0; head < bfsQueue.size(); ++head) {
+		SearchmapPoint cur = bfsQueue[head];
+		unsigned short dist = bfsDist[(cur.y - bounds.y) * ClusterSize + cur.x - bounds.x];
+		for (const Point& step : steps) {
+			SearchmapPoint next = cur + step;
+			if (!bounds.PointInside(next)) continue;
+			unsigned short& nextDist = bfsDist[(next.y - bounds.y) * ClusterSize + next.x - bounds.x];
+			if (nextDist != Unreachable || !CellWalkable(props, next)) continue;
+			nextDist = dist + 1;
+			bfsQueue.push_back(next);
+		}
+	}
+}
+
+void PathClusterGraph::CostsFrom(const TileProps& props, const Cluster& cluster, const SearchmapPoint& from, std::vector<unsigned short>& costs)
+{
+	Flood(props, cluster.bounds, from);
+	const Region& bounds = cluster.bounds;
+	costs.clear();
+	for (const Entrance& entrance : cluster.entrances) {
+		const SearchmapPoint& p = entrance.cell;
+		costs.push_back(bfsDist[(p.y - bounds.y) * ClusterSize + p.x - bounds.x]);
+	}
+}
+
+void PathClusterGraph::BuildCluster(const TileProps& props, Cluster& cluster)
+{
+	const Region& b = cluster.bounds;
+	std::vector<Entrance>& entrances = cluster.entrances;
+	entrances.clear();
+	int right = b.x + b.w - 1;
+	int bottom = b.y + b.h - 1;
+	if (b.x > 0) {
+		ScanBorder(props, b.origin, Point(0, 1), Point(-1, 0), b.h, entrances);
+	}
+	if (right < mapSize.w - 1) {
+		ScanBorder(props, Point(right, b.y), Point(0, 1), Point(1, 0), b.h, entrances);
+	}
+	if (b.y > 0) {
+		ScanBorder(props, b.origin, Point(1, 0), Point(0, -1), b.w, entrances);
+	}
+	if (bottom < mapSize.h - 1) {
+		ScanBorder(props, Point(b.x, bottom), Point(1, 0), Point(0, 1), b.w, entrances);
+	}
+
+	size_t count = entrances.size();
+	cluster.costs.resize(count * count);
+	std::vector<unsigned short> row;
+	for (size_t i = 0; i < count; ++i) {
+		CostsFrom(props, cluster, entrances[i].cell, row);
+		std::copy(row.begin(), row.end(), cluster.costs.begin() + i * count);
+	}
+	cluster.dirty = false;
+}
+
+size_t PathClusterGraph::FindEntrance(int clusterIdx, const SearchmapPoint& cell, const SearchmapPoint& across) const
+{
+	const std::vector<Entrance>& entrances = clusters[clusterIdx].entrances;
+	for (size_t i = 0; i < entrances.size(); ++i) {
+		if (entrances[i].cell == cell && entrances[i].across == across) {
+			return i;
+		}
+	}
+	return NO_NODE;
+}
+
+size_t PathClusterGraph::GetEntranceCount() const
+{
+	size_t count = 0;
+	for (const Cluster& cluster : clusters) {
+		count += cluster.entrances.size();
+	}
+	return count;
+}
+
+bool PathClusterGraph::FindCorridor(const TileProps& props, const SearchmapPoint& s, const SearchmapPoint& d)
+{
+	Update(props);
+
+	int startCluster = ClusterIndex(s);
+	int goalCluster = ClusterIndex(d);
+	if (startCluster < 0 || goalCluster < 0 || startCluster == goalCluster) return false;
+
+	// node ids: the entrances of each cluster in turn, then the start and the goal
+	nodeBase.resize(clusters.size() + 1);
+	nodeBase[0] = 0;
+	for (size_t c = 0; c < clusters.size(); ++c) {
+		nodeBase[c + 1] = nodeBase[c] + clusters[c].entrances.size();
+	}
+	const size_t startId = nodeBase.back();
+	const size_t goalId = startId + 1;
+
+	CostsFrom(props, clusters[startCluster], s, startCosts);
+	CostsFrom(props, clusters[goalCluster], d, goalCosts);
+
+	auto clusterOf = [&](size_t id) -> int {
+		if (id == startId) return startCluster;
+		if (id == goalId) return goalCluster;
+		return int(std::upper_bound(nodeBase.begin(), nodeBase.end(), id) - nodeBase.begin()) - 1;
+	};
+	auto cellOf = [&](size_t id) -> SearchmapPoint {
+		if (id == startId) return s;
+		if (id == goalId) return d;
+		int c = clusterOf(id);
+		return clusters[c].entrances[id - nodeBase[c]].cell;
+	};
+
+	using QueueNode = std::pair<unsigned int, size_t>;
+	std::priority_queue<QueueNode, std::vector<QueueNode>, std::greater<QueueNode>> open;
+	nodeCost.assign(goalId + 1, std::numeric_limits<unsigned int>::max());
+	nodeParent.assign(goalId + 1, NO_NODE);
+
+	auto relax = [&](size_t from, size_t to, unsigned int cost) {
+		unsigned int newCost = nodeCost[from] + cost;
+		if (newCost >= nodeCost[to]) return;
+		nodeCost[to] = newCost;
+		nodeParent[to] = from;
+		SearchmapPoint p = cellOf(to);
+		unsigned int heuristic = std::abs(p.x - d.x) + std::abs(p.y - d.y);
+		open.push(QueueNode(newCost + heuristic, to));
+	};
+
+	nodeCost[startId] = 0;
+	open.push(QueueNode(0, startId));
+	bool found = false;
+	while (!open.empty()) {
+		QueueNode top = open.top();
+		open.pop();
+		size_t id = top.second;
+		SearchmapPoint p = cellOf(id);
+		if (top.first != nodeCost[id] + std::abs(p.x - d.x) + std::abs(p.y - d.y)) {
+			continue; // stale entry
+		}
+		if (id == goalId) {
+			found = true;
+			break;
+		}
+
+		if (id == startId) {
+			size_t base = nodeBase[startCluster];
+			for (size_t i = 0; i < startCosts.size(); ++i) {
+				if (startCosts[i] != Unreachable) relax(id, base + i, startCosts[i]);
+			}
+			continue;
+		}
+
+		int c = clusterOf(id);
+		const Cluster& cluster = clusters[c];
+		size_t i = id - nodeBase[c];
+		size_t count = cluster.entrances.size();
+		for (size_t j = 0; j < count; ++j) {
+			unsigned short cost = cluster.costs[i * count + j];
+			if (j != i && cost != Unreachable) relax(id, nodeBase[c] + j, cost);
+		}
+
+		const Entrance& entrance = cluster.entrances[i];
+		int neighbour = ClusterIndex(entrance.across);
+		size_t j = neighbour < 0 ? NO_NODE : FindEntrance(neighbour, entrance.across, entrance.cell);
+		if (j != NO_NODE) relax(id, nodeBase[neighbour] + j, 1);
+
+		if (c == goalCluster && goalCosts[i] != Unreachable) {
+			relax(id, goalId, goalCosts[i]);
+		}
+	}
+	if (!found) return false;
+
+	// mark the clusters along the route and their neighbours, so the refined path has some slack
+	corridor.assign(clusters.size(), false);
+	for (size_t id = goalId; id != NO_NODE; id = nodeParent[id]) {
+		int c = clusterOf(id);
+		int cx = c % gridSize.w;
+		int cy = c / gridSize.w;
+		for (int y = std::max(0, cy - 1); y <= std::min(gridSize.h - 1, cy + 1); ++y) {
+			for (int x = std::max(0, cx - 1); x <= std::min(gridSize.w - 1, cx + 1); ++x) {
+				corridor[y * gridSize.w + x] = true;
+			}
+		}
+	}
+	return true;
+}
+
+bool PathClusterGraph::InCorridor(const SearchmapPoint& p) const
+{
+	int idx = ClusterIndex(p);
+	return idx >= 0 && size_t(idx) < corridor.size() && corridor[idx];
+}
+
+}
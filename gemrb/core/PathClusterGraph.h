@@ -0,0 +1,102 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef PATHCLUSTERGRAPH_H
+#define PATHCLUSTERGRAPH_H
+
+#include "exports.h"
+
+#include "PathFinder.h"
+#include "Region.h"
+
+#include <vector>
+
+namespace GemRB {
+
+class TileProps;
+
+// Abstract graph for hierarchical pathfinding (HPA*, see Botea et al., 2004)
+// The searchmap is cut into square clusters; walkable runs along the cluster
+// borders become entrances and the walking distances between the entrances
+// of a cluster are cached. Only the static searchmap and the doors are
+// considered, actors are left to the full search.
+// A query first finds a route through the cluster graph and then the regular
+// pathfinder is restricted to the clusters along it (the corridor).
+class GEM_EXPORT PathClusterGraph {
+public:
+	static constexpr int ClusterSize = 16; // in searchmap cells
+
+	// drop everything, eg. when the searchmap is replaced
+	void Clear();
+	// the door bits of these searchmap cells changed, so the touching clusters need rebuilding
+	void Invalidate(const Region& tiles);
+	// builds or refreshes the dirty clusters
+	void Update(const TileProps& props);
+
+	// the graph only pays off if the endpoints are a few clusters apart
+	bool IsWorthUsing(const SearchmapPoint& s, const SearchmapPoint& d) const;
+	// finds a route through the cluster graph and marks the corridor of clusters along it
+	// returns false if there is no route, the corridor is then left untouched
+	bool FindCorridor(const TileProps& props, const SearchmapPoint& s, const SearchmapPoint& d);
+	bool InCorridor(const SearchmapPoint& p) const;
+
+	size_t GetEntranceCount() const;
+
+private:
+	static constexpr unsigned short Unreachable = 0xffff;
+
+	struct Entrance {
+		SearchmapPoint cell;
+		SearchmapPoint across; // the matching cell in the neighbouring cluster
+	};
+
+	struct Cluster {
+		Region bounds;
+		std::vector<Entrance> entrances;
+		std::vector<unsigned short> costs; // entrances x entrances
+		bool dirty = true;
+	};
+
+	Size mapSize;
+	Size gridSize;
+	std::vector<Cluster> clusters;
+	bool anyDirty = true;
+
+	// scratch space for the queries
+	std::vector<unsigned short> bfsDist;
+	std::vector<SearchmapPoint> bfsQueue;
+	std::vector<unsigned short> startCosts;
+	std::vector<unsigned short> goalCosts;
+	std::vector<size_t> nodeBase;
+	std::vector<unsigned int> nodeCost;
+	std::vector<size_t> nodeParent;
+	std::vector<bool> corridor;
+
+	int ClusterIndex(const SearchmapPoint& p) const;
+	void BuildCluster(const TileProps& props, Cluster& cluster);
+	void ScanBorder(const TileProps& props, SearchmapPoint cell, const Point& step, const Point& acrossOffset, int length, std::vector<Entrance>& entrances) const;
+	void Flood(const TileProps& props, const Region& bounds, const SearchmapPoint& from);
+	void CostsFrom(const TileProps& props, const Cluster& cluster, const SearchmapPoint& from, std::vector<unsigned short>& costs);
+	size_t FindEntrance(int clusterIdx, const SearchmapPoint& cell, const SearchmapPoint& across) const;
+};
+
+}
+
+#endif
@@ -34,7 +34,6 @@
 // Moving to each node in the path thus becomes an automatic regulation problem
 // which is solved with a P regulator, see Scriptable.cpp
 
-#include "FibonacciHeap.h"
 #include "GameData.h"
 #include "Map.h"
 #include "PathFinder.h"
@@ -42,6 +41,7 @@
 #include "Scriptable/Actor.h"
 
 #include <array>
+#include <chrono>
 #include <limits>
 
 namespace GemRB {
@@ -58,9 +58,10 @@ constexpr std::array<double, RAND_DEGREES_OF_FREEDOM> dxRand{{0.000, -0.383, -0.
 constexpr std::array<double, RAND_DEGREES_OF_FREEDOM> dyRand{{1.000, 0.924, 0.707, 0.383, 0.000, -0.383, -0.707, -0.924, -1.000, -0.924, -0.707, -0.383, 0.000, 0.383, 0.707, 0.924}};
 
 // Find the best path of limited length that brings us the farthest from d
-PathListNode *Map::RunAway(const Point &s, const Point &d, unsigned int size, int maxPathLength, bool backAway, const Actor *caller) const
+bool Map::RunAway(Path& path, const Point &s, const Point &d, unsigned int size, int maxPathLength, bool backAway, const Actor *caller) const
 {
-	if (!caller || !caller->GetSpeed()) return nullptr;
+	path.clear();
+	if (!caller || !caller->GetSpeed()) return false;
 	Point p = s;
 	double dx = s.x - d.x;
 	double dy = s.y - d.y;
@@ -82,12 +83,13 @@ PathListNode *Map::RunAway(const Point &s, const Point &d, unsigned int size, in
 	}
 	int flags = PF_SIGHT;
 	if (backAway) flags |= PF_BACKAWAY;
-	return FindPath(s, p, size, size, flags, caller);
+	return FindPath(path, s, p, size, size, flags, caller);
 }
 
-PathListNode *Map::RandomWalk(const Point &s, int size, int radius, const Actor *caller) const
+bool Map::RandomWalk(Path& path, const Point &s, int size, int radius, const Actor *caller) const
 {
-	if (!caller || !caller->GetSpeed()) return nullptr;
+	path.clear();
+	if (!caller || !caller->GetSpeed()) return false;
 	NavmapPoint p = s;
 	size_t i = RAND<size_t>(0, RAND_DEGREES_OF_FREEDOM - 1);
 	double dx = 3 * dxRand[i];
@@ -100,7 +102,7 @@ PathListNode *Map::RandomWalk(const Point &s, int size, int radius, const Actor
 			tries++;
 			// Give up if backed into a corner
 			if (tries > RAND_DEGREES_OF_FREEDOM) {
-				return nullptr;
+				return false;
 			}
 			// Random rotation
 			i = RAND<size_t>(0, RAND_DEGREES_OF_FREEDOM - 1);
@@ -117,30 +119,20 @@ PathListNode *Map::RandomWalk(const Point &s, int size, int radius, const Actor
 		p.x -= dx;
 		p.y -= dy;
 	}
-	PathListNode *step = new PathListNode;
+	PathNode step;
 	const Size& mapSize = PropsSize();
-	step->point = Clamp(p, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
-	step->Parent = nullptr;
-	step->Next = nullptr;
-	step->orient = GetOrient(p, s);
-	return step;
+	step.point = Clamp(p, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
+	step.orient = GetOrient(p, s);
+	path.push_back(step);
+	return true;
 }
 
 bool Map::TargetUnreachable(const Point &s, const Point &d, unsigned int size, bool actorsAreBlocking) const
 {
 	int flags = PF_SIGHT;
 	if (actorsAreBlocking) flags |= PF_ACTORS_ARE_BLOCKING;
-	PathListNode *path = FindPath(s, d, size, 0, flags);
-	bool targetUnreachable = path == nullptr;
-	if (!targetUnreachable) {
-		PathListNode *thisNode = path;
-		while (thisNode) {
-			PathListNode *nextNode = thisNode->Next;
-			delete thisNode;
-			thisNode = nextNode;
-		}
-	}
-	return targetUnreachable;
+	Path path;
+	return !FindPath(path, s, d, size, 0, flags);
 }
 
 // Use this function when you target something by a straight line projectile (like a lightning bolt, arrow, etc)
@@ -283,23 +275,22 @@ Path Map::GetLinePath(const Point &start, const Point &dest, int Speed, orient_t
 	return path;
 }
 
-PathListNode *Map::GetLine(const Point &p, int steps, orient_t orient) const
+PathNode Map::GetLine(const Point &p, int steps, orient_t orient) const
 {
-	PathListNode *step = new PathListNode;
-	step->point.x = p.x + steps * SEARCHMAP_SQUARE_DIAGONAL * dxRand[orient];
-	step->point.y = p.y + steps * SEARCHMAP_SQUARE_DIAGONAL * dyRand[orient];
+	PathNode step;
+	step.point.x = p.x + steps * SEARCHMAP_SQUARE_DIAGONAL * dxRand[orient];
+	step.point.y = p.y + steps * SEARCHMAP_SQUARE_DIAGONAL * dyRand[orient];
 	const Size& mapSize = PropsSize();
-	step->point = Clamp(step->point, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
-	step->orient = GetOrient(step->point, p);
-	step->Next = nullptr;
-	step->Parent = nullptr;
+	step.point = Clamp(step.point, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
+	step.orient = GetOrient(step.point, p);
 	return step;
 }
 
 // Find a path from start to goal, ending at the specified distance from the
 // target (the goal must be in sight of the end, if PF_SIGHT is specified)
-PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, unsigned int minDistance, int flags, const Actor *caller) const
+bool Map::FindPath(Path& path, const Point &s, const Point &d, unsigned int size, unsigned int minDistance, int flags, const Actor *caller) const
 {
+	path.clear();
 	if (core->InDebugMode(ID_PATHFINDER)) Log(DEBUG, "FindPath", "s = {}, d = {}, caller = {}, dist = {}, size = {}", s, d, caller ? MBStringFromString(caller->GetShortName()) : "nullptr", minDistance, size);
 	
 	// TODO: we could optimize this function further by doing everything in SearchmapPoint and converting at the end
@@ -313,35 +304,81 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 		AdjustPositionNavmap(nmptDest);
 	}
 	
-	if (nmptDest == nmptSource) return nullptr;
+	if (nmptDest == nmptSource) return false;
 	
 	SearchmapPoint smptSource = Map::ConvertCoordToTile(nmptSource);
 	SearchmapPoint smptDest = Map::ConvertCoordToTile(nmptDest);
 	
 	if (minDistance < size && !(GetBlockedInRadiusTile(smptDest, size) & (PathMapFlags::PASSABLE | PathMapFlags::ACTOR))) {
 		Log(DEBUG, "FindPath", "{} can't fit in destination", caller ? MBStringFromString(caller->GetShortName()) : "nullptr");
-		return nullptr;
+		return false;
+	}
+
+	const Size& mapSize = PropsSize();
+	if (!mapSize.PointInside(smptSource)) return false;
+
+	bool hierarchical = core->config.HierarchicalPathfinding && pathClusters.IsWorthUsing(smptSource, smptDest)
+		&& pathClusters.FindCorridor(tileProps, smptSource, smptDest);
+	if (!hierarchical) {
+		return SearchPath(path, nmptSource, nmptDest, d, size, minDistance, flags, caller, false);
+	}
+
+	if (!core->InDebugMode(ID_PATHFINDER)) {
+		// the corridor ignores actors, so fall back to the full search if they block it
+		return SearchPath(path, nmptSource, nmptDest, d, size, minDistance, flags, caller, true) ||
+			SearchPath(path, nmptSource, nmptDest, d, size, minDistance, flags, caller, false);
 	}
 
+	// compare the two planners side by side
+	auto pathLength = [&nmptSource](const Path& p) {
+		unsigned int length = 0;
+		NavmapPoint prev = nmptSource;
+		for (const PathNode& node : p) {
+			length += Distance(prev, node.point);
+			prev = node.point;
+		}
+		return length;
+	};
+	using namespace std::chrono;
+	auto start = steady_clock::now();
+	bool found = SearchPath(path, nmptSource, nmptDest, d, size, minDistance, flags, caller, true);
+	auto corridorTime = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+	Path flatPath;
+	start = steady_clock::now();
+	bool flatFound = SearchPath(flatPath, nmptSource, nmptDest, d, size, minDistance, flags, caller, false);
+	auto flatTime = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+	Log(DEBUG, "FindPath", "Hierarchical: {}us, found = {}, length = {} ({} entrances); flat: {}us, found = {}, length = {}",
+		corridorTime, found, pathLength(path), pathClusters.GetEntranceCount(), flatTime, flatFound, pathLength(flatPath));
+	if (!found) {
+		path = std::move(flatPath);
+	}
+	return found || flatFound;
+}
+
+bool Map::SearchPath(Path& path, const NavmapPoint& nmptSource, NavmapPoint nmptDest, const Point& d, unsigned int size, unsigned int minDistance, int flags, const Actor* caller, bool inCorridor) const
+{
+	path.clear();
+	SearchmapPoint smptSource = Map::ConvertCoordToTile(nmptSource);
+	SearchmapPoint smptDest = Map::ConvertCoordToTile(nmptDest);
 	const Size& mapSize = PropsSize();
-	if (!mapSize.PointInside(smptSource)) return nullptr;
 
 	// Initialize data structures
-	FibonacciHeap<PQNode> open;
-	std::vector<bool> isClosed(mapSize.Area(), false);
-	std::vector<NavmapPoint> parents(mapSize.Area(), Point(0, 0));
-	std::vector<unsigned short> distFromStart(mapSize.Area(), std::numeric_limits<unsigned short>::max());
-	distFromStart[smptSource.y * mapSize.w + smptSource.x] = 0;
-	parents[smptSource.y * mapSize.w + smptSource.x] = nmptSource;
-	open.emplace(PQNode(nmptSource, 0));
+	PathFinderScratch& nodes = pathScratch;
+	nodes.Reset(mapSize.Area());
+	PathFinderScratch::Node& sourceNode = nodes[smptSource.y * mapSize.w + smptSource.x];
+	sourceNode.distFromStart = 0;
+	sourceNode.parent = nmptSource;
+	nodes.PushOpen(PQNode(nmptSource, 0));
 	bool foundPath = false;
 	unsigned int squaredMinDist = minDistance * minDistance;
 
-	while (!open.empty()) {
-		NavmapPoint nmptCurrent = open.top().point;
-		open.pop();
+	while (!nodes.OpenEmpty()) {
+		NavmapPoint nmptCurrent = nodes.PopOpen().point;
 		SearchmapPoint smptCurrent = Map::ConvertCoordToTile(nmptCurrent);
-		if (parents[smptCurrent.y * mapSize.w + smptCurrent.x].IsZero()) {
+		PathFinderScratch::Node& currentNode = nodes[smptCurrent.y * mapSize.w + smptCurrent.x];
+		if (currentNode.parent.IsZero()) {
 			continue;
 		}
 
@@ -350,7 +387,7 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 			foundPath = true;
 			break;
 		} else if (minDistance) {
-			if (parents[smptCurrent.y * mapSize.w + smptCurrent.x] != nmptCurrent &&
+			if (currentNode.parent != nmptCurrent &&
 					SquaredDistance(nmptCurrent, nmptDest) < squaredMinDist) {
 				if (!(flags & PF_SIGHT) || IsVisibleLOS(nmptCurrent, d)) {
 					smptDest = smptCurrent;
@@ -360,15 +397,18 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 				}
 			}
 		}
-		isClosed[smptCurrent.y * mapSize.w + smptCurrent.x] = true;
+		currentNode.closed = true;
 
 		for (size_t i = 0; i < DEGREES_OF_FREEDOM; i++) {
 			NavmapPoint nmptChild(nmptCurrent.x + 16 * dxAdjacent[i], nmptCurrent.y + 12 * dyAdjacent[i]);
 			SearchmapPoint smptChild = Map::ConvertCoordToTile(nmptChild);
 			// Outside map
 			if (smptChild.x < 0 ||	smptChild.y < 0 || smptChild.x >= mapSize.w || smptChild.y >= mapSize.h) continue;
+			// Outside the corridor picked by the cluster graph
+			if (inCorridor && !pathClusters.InCorridor(smptChild)) continue;
 			// Already visited
-			if (isClosed[smptChild.y * mapSize.w + smptChild.x]) continue;
+			PathFinderScratch::Node& childNode = nodes[smptChild.y * mapSize.w + smptChild.x];
+			if (childNode.closed) continue;
 			// If there's an actor, check it can be bumped away
 			const Actor* childActor = GetActor(nmptChild, GA_NO_DEAD | GA_NO_UNSCHEDULED);
 			bool childIsUnbumpable = childActor && childActor != caller && (flags & PF_ACTORS_ARE_BLOCKING || !childActor->ValidTarget(GA_ONLY_BUMPABLE));
@@ -380,27 +420,26 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 
 			// Weighted heuristic. Finds sub-optimal paths but should be quite a bit faster
 			const float HEURISTIC_WEIGHT = 1.5;
-			SearchmapPoint smptCurrent2 = Map::ConvertCoordToTile(nmptCurrent);
-			NavmapPoint nmptParent = parents[smptCurrent2.y * mapSize.w + smptCurrent2.x];
-			unsigned short oldDist = distFromStart[smptChild.y * mapSize.w + smptChild.x];
+			NavmapPoint nmptParent = currentNode.parent;
+			unsigned short oldDist = childNode.distFromStart;
 			// Theta-star path if there is LOS
 			if (IsWalkableTo(nmptParent, nmptChild, flags & PF_ACTORS_ARE_BLOCKING, caller)) {
 				SearchmapPoint smptParent = Map::ConvertCoordToTile(nmptParent);
-				unsigned short newDist = distFromStart[smptParent.y * mapSize.w + smptParent.x] + Distance(smptParent, smptChild);
+				unsigned short newDist = nodes[smptParent.y * mapSize.w + smptParent.x].distFromStart + Distance(smptParent, smptChild);
 				if (newDist < oldDist) {
-					parents[smptChild.y * mapSize.w + smptChild.x] = nmptParent;
-					distFromStart[smptChild.y * mapSize.w + smptChild.x] = newDist;
+					childNode.parent = nmptParent;
+					childNode.distFromStart = newDist;
 				}
 			// Fall back to A-star path
 			} else if (IsWalkableTo(nmptCurrent, nmptChild, flags & PF_ACTORS_ARE_BLOCKING, caller)) {
-				unsigned short newDist = distFromStart[smptCurrent2.y * mapSize.w + smptCurrent2.x] + Distance(smptCurrent2, smptChild);
+				unsigned short newDist = currentNode.distFromStart + Distance(smptCurrent, smptChild);
 				if (newDist < oldDist) {
-					parents[smptChild.y * mapSize.w + smptChild.x] = nmptCurrent;
-					distFromStart[smptChild.y * mapSize.w + smptChild.x] = newDist;
+					childNode.parent = nmptCurrent;
+					childNode.distFromStart = newDist;
 				}
 			}
 
-			if (distFromStart[smptChild.y * mapSize.w + smptChild.x] < oldDist) {
+			if (childNode.distFromStart < oldDist) {
 				// Calculate heuristic
 				int xDist = smptChild.x - smptDest.x;
 				int yDist = smptChild.y - smptDest.y;
@@ -410,38 +449,32 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 				int crossProduct = std::abs(xDist * dyCross - yDist * dxCross) >> 3;
 				double distance = std::hypot(xDist, yDist);
 				double heuristic = HEURISTIC_WEIGHT * (distance + crossProduct);
-				double estDist = distFromStart[smptChild.y * mapSize.w + smptChild.x] + heuristic;
-				PQNode newNode(nmptChild, estDist);
-				open.emplace(newNode);
+				double estDist = childNode.distFromStart + heuristic;
+				nodes.PushOpen(PQNode(nmptChild, estDist));
 			}
 		}
 	}
 
 	if (foundPath) {
-		PathListNode *resultPath = nullptr;
 		NavmapPoint nmptCurrent = nmptDest;
 		NavmapPoint nmptParent;
 		SearchmapPoint smptCurrent = Map::ConvertCoordToTile(nmptCurrent);
-		while (!resultPath || nmptCurrent != parents[smptCurrent.y * mapSize.w + smptCurrent.x]) {
-			nmptParent = parents[smptCurrent.y * mapSize.w + smptCurrent.x];
-			PathListNode *newStep = new PathListNode;
-			newStep->point = nmptCurrent;
-			newStep->Next = resultPath;
-			newStep->Parent = nullptr;
+		while (path.empty() || nmptCurrent != nodes[smptCurrent.y * mapSize.w + smptCurrent.x].parent) {
+			nmptParent = nodes[smptCurrent.y * mapSize.w + smptCurrent.x].parent;
+			orient_t orient;
 			if (flags & PF_BACKAWAY) {
-				newStep->orient = GetOrient(nmptParent, nmptCurrent);
+				orient = GetOrient(nmptParent, nmptCurrent);
 			} else {
-				newStep->orient = GetOrient(nmptCurrent, nmptParent);
-			}
-			if (resultPath) {
-				resultPath->Parent = newStep;
+				orient = GetOrient(nmptCurrent, nmptParent);
 			}
-			resultPath = newStep;
+			path.push_back(PathNode { nmptCurrent, orient });
 			nmptCurrent = nmptParent;
 
 			smptCurrent = Map::ConvertCoordToTile(nmptCurrent);
 		}
-		return resultPath;
+		// we collected the steps backwards
+		std::reverse(path.begin(), path.end());
+		return true;
 	} else if (core->InDebugMode(ID_PATHFINDER)) {
 		if (caller) {
 			Log(DEBUG, "FindPath", "Pathing failed for {}", fmt::WideToChar{caller->GetShortName()});
@@ -450,7 +483,7 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 		}
 	}
 
-	return nullptr;
+	return false;
 }
 
 void Map::NormalizeDeltas(double &dx, double &dy, double factor)
@@ -26,7 +26,10 @@
 #include "Region.h"
 #include "Resource.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <vector>
 
 namespace GemRB {
@@ -101,6 +104,63 @@ public:
 
 };
 
+// Per map scratch space for the pathfinder, so searches don't have to allocate
+// Nodes are stamped with the search generation and are (re)initialized lazily
+// on first access in a search, so nothing needs to be cleared between searches
+class PathFinderScratch {
+public:
+	struct Node {
+		NavmapPoint parent;
+		unsigned short distFromStart;
+		bool closed;
+	};
+
+	void Reset(size_t area)
+	{
+		if (stamps.size() != area) {
+			nodes.resize(area);
+			stamps.assign(area, 0);
+			generation = 0;
+		}
+		if (++generation == 0) {
+			// wrapped around, so the old stamps can't be trusted anymore
+			std::fill(stamps.begin(), stamps.end(), 0);
+			generation = 1;
+		}
+		open.clear();
+	}
+
+	Node& operator[](size_t idx)
+	{
+		if (stamps[idx] != generation) {
+			stamps[idx] = generation;
+			nodes[idx] = { Point(0, 0), std::numeric_limits<unsigned short>::max(), false };
+		}
+		return nodes[idx];
+	}
+
+	// binary min-heap of the open nodes
+	bool OpenEmpty() const { return open.empty(); }
+	void PushOpen(const PQNode& node)
+	{
+		open.push_back(node);
+		std::push_heap(open.begin(), open.end(), std::greater<PQNode>());
+	}
+	PQNode PopOpen()
+	{
+		std::pop_heap(open.begin(), open.end(), std::greater<PQNode>());
+		PQNode top = open.back();
+		open.pop_back();
+		return top;
+	}
+
+private:
+	std::vector<Node> nodes;
+	std::vector<uint32_t> stamps;
+	uint32_t generation = 0;
+	std::vector<PQNode> open;
+};
+
 }
 
 #endif
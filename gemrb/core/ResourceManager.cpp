@@ -35,19 +35,99 @@ bool ResourceManager::AddSource(const char *path, const char *description, Plugi
 		return false;
 	}
 
+	bool isVolatile = flags & RM_VOLATILE_SOURCE;
 	if (flags & RM_REPLACE_SAME_SOURCE) {
 		for (auto& path2 : searchPath) {
-			if (description == path2->GetDescription()) {
-				path2 = source;
+			if (description == path2.source->GetDescription()) {
+				path2.source = source;
+				path2.isVolatile = isVolatile;
 				break;
 			}
 		}
 	} else {
-		searchPath.push_back(source);
+		searchPath.push_back({ source, isVolatile });
 	}
+	ClearLocations();
 	return true;
 }
 
+void ResourceManager::ClearLocations()
+{
+	std::lock_guard<std::mutex> lock(locationLock);
+	typeLocations.clear();
+	descLocations.clear();
+}
+
+// longer names can't be keyed by a ResRef, so they are always looked up
+static bool CanRemember(StringView resRef)
+{
+	return resRef.length() <= ResRef::Size;
+}
+
+ResourceManager::Location ResourceManager::FindLocation(StringView resRef, SClass_ID type) const
+{
+	bool remember = CanRemember(resRef);
+	ResRef key;
+	if (remember) {
+		key = ResRef(resRef.c_str(), resRef.length());
+		std::lock_guard<std::mutex> lock(locationLock);
+		const ResRefMap<Location>& locations = typeLocations[type];
+		auto it = locations.find(key);
+		if (it != locations.end()) {
+			return it->second;
+		}
+	}
+
+	Location location { 0, -1 };
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		const SearchPath& path = searchPath[i];
+		if (!path.isVolatile && path.source->HasResource(resRef, type)) {
+			location.path = int(i);
+			break;
+		}
+	}
+
+	if (remember) {
+		std::lock_guard<std::mutex> lock(locationLock);
+		typeLocations[type][key] = location;
+	}
+	return location;
+}
+
+ResourceManager::Location ResourceManager::FindLocation(StringView resRef, const TypeID *type) const
+{
+	bool remember = CanRemember(resRef);
+	ResRef key;
+	if (remember) {
+		key = ResRef(resRef.c_str(), resRef.length());
+		std::lock_guard<std::mutex> lock(locationLock);
+		const ResRefMap<Location>& locations = descLocations[type];
+		auto it = locations.find(key);
+		if (it != locations.end()) {
+			return it->second;
+		}
+	}
+
+	Location location { 0, -1 };
+	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
+	for (size_t d = 0; d < types.size() && location.path == -1; ++d) {
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			const SearchPath& path = searchPath[i];
+			if (!path.isVolatile && path.source->HasResource(resRef, types[d])) {
+				location.desc = int(d);
+				location.path = int(i);
+				break;
+			}
+		}
+	}
+
+	if (remember) {
+		std::lock_guard<std::mutex> lock(locationLock);
+		descLocations[type][key] = location;
+	}
+	return location;
+}
+
 static void PrintPossibleFiles(std::string& buffer, StringView ResRef, const TypeID *type)
 {
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
@@ -60,12 +140,14 @@ bool ResourceManager::Exists(StringView ResRef, SClass_ID type, bool silent) con
 {
 	if (ResRef.empty())
 		return false;
-	// TODO: check various caches
 	for (const auto& path : searchPath) {
-		if (path->HasResource(ResRef, type)) {
+		if (path.isVolatile && path.source->HasResource(ResRef, type)) {
 			return true;
 		}
 	}
+	if (FindLocation(ResRef, type).path != -1) {
+		return true;
+	}
 	if (!silent) {
 		Log(WARNING, "ResourceManager", "'{}.{}' not found...",
 			ResRef, core->TypeExt(type));
@@ -77,15 +159,17 @@ bool ResourceManager::Exists(StringView ResRef, const TypeID *type, bool silent)
 {
 	if (ResRef[0] == '\0')
 		return false;
-	// TODO: check various caches
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (const auto& type2 : types) {
 		for (const auto& path : searchPath) {
-			if (path->HasResource(ResRef, type2)) {
+			if (path.isVolatile && path.source->HasResource(ResRef, type2)) {
 				return true;
 			}
 		}
 	}
+	if (FindLocation(ResRef, type).path != -1) {
+		return true;
+	}
 	if (!silent) {
 		std::string buffer = fmt::format("Couldn't find '{}'... Tried ", ResRef);
 		PrintPossibleFiles(buffer, ResRef,type);
@@ -98,14 +182,26 @@ DataStream* ResourceManager::GetResource(StringView ResRef, SClass_ID type, bool
 {
 	if (ResRef.empty())
 		return nullptr;
-	for (const auto& path : searchPath) {
-		DataStream *ds = path->GetResource(ResRef, type);
+	// only the first non-volatile source that has the resource needs to be asked,
+	// unless it fails to deliver, then we fall back to asking all the rest
+	Location location = FindLocation(ResRef, type);
+	bool skipStable = true;
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		const SearchPath& path = searchPath[i];
+		bool atLocation = int(i) == location.path;
+		if (!path.isVolatile && skipStable && !atLocation) {
+			continue;
+		}
+		DataStream *ds = path.source->GetResource(ResRef, type);
 		if (ds) {
 			if (!silent) {
-				Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.", ResRef, core->TypeExt(type), path->GetDescription());
+				Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.", ResRef, core->TypeExt(type), path.source->GetDescription());
 			}
 			return ds;
 		}
+		if (atLocation) {
+			skipStable = false;
+		}
 	}
 	if (!silent) {
 		Log(ERROR, "ResourceManager", "Couldn't find '{}.{}'.", ResRef, core->TypeExt(type));
@@ -120,10 +216,18 @@ Resource* ResourceManager::GetResource(StringView ResRef, const TypeID *type, bo
 	if (!silent) {
 		Log(MESSAGE, "ResourceManager", "Searching for '{}'...", ResRef);
 	}
+	Location location = FindLocation(ResRef, type);
+	bool skipStable = true;
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
-	for (const auto& type2 : types) {
-		for (const auto& path : searchPath) {
-			DataStream *str = path->GetResource(ResRef, type2);
+	for (size_t d = 0; d < types.size(); ++d) {
+		const ResourceDesc& type2 = types[d];
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			const SearchPath& path = searchPath[i];
+			bool atLocation = int(d) == location.desc && int(i) == location.path;
+			if (!path.isVolatile && skipStable && !atLocation) {
+				continue;
+			}
+			DataStream *str = path.source->GetResource(ResRef, type2);
 			if (!str && useCorrupt && core->UseCorruptedHack) {
 				// don't look at other paths if requested
 				core->UseCorruptedHack = false;
@@ -135,11 +239,14 @@ Resource* ResourceManager::GetResource(StringView ResRef, const TypeID *type, bo
 				if (res) {
 					if (!silent) {
 						Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.",
-							ResRef, type2.GetExt(), path->GetDescription());
+							ResRef, type2.GetExt(), path.source->GetDescription());
 					}
 					return res;
 				}
 			}
+			if (atLocation) {
+				skipStable = false;
+			}
 		}
 	}
 	if (!silent) {
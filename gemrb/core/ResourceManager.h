@@ -27,11 +27,14 @@
 #include "Resource.h"
 #include "ResourceSource.h"
 
+#include <mutex>
 #include <vector>
 
 namespace GemRB {
 
 #define RM_REPLACE_SAME_SOURCE 1
+// the contents of the source change at runtime (eg. the cache), so lookups can't be remembered
+#define RM_VOLATILE_SOURCE 2
 
 class ResourceSource;
 class TypeID;
@@ -58,7 +61,25 @@ public:
 	Resource* GetResource(StringView resname, const TypeID *type, bool silent = false, bool useCorrupt = false) const;
 
 private:
-	std::vector<std::shared_ptr<ResourceSource> > searchPath;
+	struct SearchPath {
+		std::shared_ptr<ResourceSource> source;
+		bool isVolatile;
+	};
+	std::vector<SearchPath> searchPath;
+
+	// remembers where the resources of the non-volatile sources are,
+	// so repeated lookups (especially of missing files) don't probe every source
+	struct Location {
+		int desc; // index into the ResourceDesc list, always 0 for plain types
+		int path; // index into searchPath, -1 if none of the non-volatile sources has it
+	};
+	mutable std::unordered_map<SClass_ID, ResRefMap<Location>> typeLocations;
+	mutable std::unordered_map<const TypeID*, ResRefMap<Location>> descLocations;
+	mutable std::mutex locationLock;
+
+	Location FindLocation(StringView resRef, SClass_ID type) const;
+	Location FindLocation(StringView resRef, const TypeID *type) const;
+	void ClearLocations();
 };
 
 }
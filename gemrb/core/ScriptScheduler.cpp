@@ -0,0 +1,90 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ScriptScheduler.h"
+
+#include "ie_stats.h"
+
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+// the share of the budget (in quarters) that may be used up before a priority has to wait
+static const long budgetShare[ScriptScheduler::PRIORITY_COUNT] = { 0, 4, 3, 2 };
+
+void ScriptScheduler::BeginTick(int newBudget)
+{
+	budget = std::max(0, newBudget);
+	tick = Stats();
+	inTick = true;
+}
+
+void ScriptScheduler::EndTick()
+{
+	inTick = false;
+	lastTick = tick;
+	window.scriptTime = std::max(window.scriptTime, tick.scriptTime);
+	window.ran += tick.ran;
+	window.deferred += tick.deferred;
+	window.worstDelay = std::max(window.worstDelay, tick.worstDelay);
+}
+
+ScriptScheduler::Stats ScriptScheduler::TakeWindow()
+{
+	Stats taken = window;
+	window = Stats();
+	return taken;
+}
+
+ScriptScheduler::Priority ScriptScheduler::Classify(const Actor* actor, bool onScreen, bool triggered)
+{
+	if (actor->InParty) return PARTY;
+	if (onScreen && actor->GetStat(IE_EA) >= EA_EVILCUTOFF) return HOSTILE;
+	if (triggered) return TRIGGERED;
+	return IDLE;
+}
+
+bool ScriptScheduler::Admit(Priority priority, unsigned int delay)
+{
+	if (!inTick) return true;
+
+	bool admit = !budget || priority == PARTY || delay >= MaxDelay;
+	if (!admit) {
+		admit = tick.scriptTime * 4 < budget * budgetShare[priority];
+	}
+
+	if (admit) {
+		tick.ran++;
+		tick.worstDelay = std::max(tick.worstDelay, delay);
+	} else {
+		tick.deferred++;
+		tick.worstDelay = std::max(tick.worstDelay, delay + 1);
+	}
+	return admit;
+}
+
+void ScriptScheduler::Charge(const clock::time_point& start)
+{
+	tick.scriptTime += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+}
+
+}
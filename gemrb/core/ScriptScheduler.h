@@ -0,0 +1,82 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SCRIPTSCHEDULER_H
+#define SCRIPTSCHEDULER_H
+
+#include "exports.h"
+
+#include <chrono>
+
+namespace GemRB {
+
+class Actor;
+
+// Decides which of the actor script evaluations due in a tick run right away
+// and which wait for a later one, so crowded areas stay within a time budget.
+// A deferred evaluation keeps its triggers queued on the actor and is retried
+// every tick, lower priorities giving way first. Nothing waits longer than
+// MaxDelay ticks, so the budget can be overrun by stale evaluations.
+class GEM_EXPORT ScriptScheduler {
+public:
+	using clock = std::chrono::steady_clock;
+
+	enum Priority {
+		PARTY,
+		HOSTILE, // on-screen enemies
+		TRIGGERED, // pending triggers or a forced update
+		IDLE,
+		PRIORITY_COUNT
+	};
+
+	static constexpr unsigned int MaxDelay = 16; // in ticks
+
+	struct Stats {
+		long scriptTime = 0; // in microseconds
+		unsigned int ran = 0;
+		unsigned int deferred = 0;
+		unsigned int worstDelay = 0; // in ticks
+	};
+
+	// budget is in microseconds, 0 runs everything
+	void BeginTick(int budget);
+	void EndTick();
+	bool InTick() const { return inTick; }
+
+	static Priority Classify(const Actor* actor, bool onScreen, bool triggered);
+	// delay is the number of ticks the evaluation has already waited
+	bool Admit(Priority priority, unsigned int delay);
+	void Charge(const clock::time_point& start);
+
+	const Stats& GetLastTick() const { return lastTick; }
+	// the worst tick and the totals since the last call
+	Stats TakeWindow();
+
+private:
+	bool inTick = false;
+	long budget = 0;
+	Stats tick;
+	Stats lastTick;
+	Stats window;
+};
+
+}
+
+#endif
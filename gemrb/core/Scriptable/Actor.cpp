@@ -1485,6 +1485,8 @@ static const PostChangeFunctionType post_change_functions[MAX_STATS] = {
 	pcf_level_barbarian, pcf_level_bard, pcf_level_cleric, pcf_level_druid, pcf_level_monk, pcf_level_paladin, pcf_level_ranger, pcf_level_sorcerer,
 	nullptr, nullptr, nullptr, nullptr, pcf_morale, pcf_bounce, nullptr, nullptr //ff
 };
+// the few stats that have a post change function, so refreshes don't scan all of them
+static std::vector<unsigned int> pcfStats;
 
 #define COL_MAIN       0
 #define COL_SPARKS     1
@@ -1588,6 +1590,12 @@ static void InitActorTables()
 	third = core->HasFeature(GF_3ED_RULES) != 0;
 	raresnd = core->HasFeature(GF_RARE_ACTION_VB) != 0;
 	iwd2class = core->HasFeature(GF_LEVELSLOT_PER_CLASS) != 0;
+	// this reruns while the class tables fail to load, so only fill it once
+	if (pcfStats.empty()) {
+		for (unsigned int i = 0; i < MAX_STATS; ++i) {
+			if (post_change_functions[i]) pcfStats.push_back(i);
+		}
+	}
 	// iwd2 has some different base class names
 	if (iwd2class) {
 		isclassnames[ISTHIEF] = "ROGUE";
@@ -2468,6 +2476,9 @@ bool Actor::SetStat(unsigned int StatIndex, stat_t Value, int pcf)
 				(*f)(this, previous, Value);
 			}
 		}
+		if (area && ActorStatIndex::IsIndexed(StatIndex)) {
+			area->ActorStatsChanged(this);
+		}
 	}
 	return true;
 }
@@ -2768,12 +2779,10 @@ void Actor::RefreshEffects(bool first, const stats_t& previous)
 		Modified[IE_NUMBEROFATTACKS] = apr;
 	}
 
-	for (int i=0; i < MAX_STATS; ++i) {
+	for (unsigned int i : pcfStats) {
 		if (first || Modified[i]!=previous[i]) {
 			PostChangeFunctionType f = post_change_functions[i];
-			if (f) {
-				(*f)(this, previous[i], Modified[i]);
-			}
+			(*f)(this, previous[i], Modified[i]);
 		}
 	}
 
@@ -2813,6 +2822,9 @@ void Actor::RefreshEffects(bool first, const stats_t& previous)
 	if (Immobile()) {
 		timeStartStep = game->Ticks;
 	}
+	if (area) {
+		area->ActorStatsChanged(this);
+	}
 }
 
 void Actor::RefreshEffects()
@@ -3597,8 +3609,7 @@ static int CheckInteract(const ieVariable& talker, const ieVariable& target)
 void Actor::HandleInteractV1(const Actor *target)
 {
 	LastTalker = target->GetGlobalID();
-	std::string interAction = fmt::format("Interact(\"{}\")", target->GetScriptName());
-	AddAction(GenerateAction(std::move(interAction)));
+	AddAction(GenerateActionDirect("Interact([-1])", target));
 }
 
 int Actor::HandleInteract(const Actor *target) const
@@ -3888,7 +3899,7 @@ bool Actor::OverrideActions()
 			case 1002:
 			case 1003:
 			case 1005:
-				action = GenerateAction("AttackReevaluate([GOODCUTOFF],10)");
+				action = GenerateActionFromTemplate("AttackReevaluate([GOODCUTOFF],10)");
 				if (action) {
 					AddActionInFront(action);
 					return true;
@@ -3924,11 +3935,11 @@ void Actor::Panic(const Scriptable *attacker, int panicmode)
 		SetBaseBit(IE_STATE_ID, STATE_PANIC, true);
 		break;
 	case PANIC_RANDOMWALK:
-		action = GenerateAction( "RandomWalk()" );
+		action = GenerateActionFromTemplate("RandomWalk()");
 		SetBaseBit(IE_STATE_ID, STATE_PANIC, true);
 		break;
 	case PANIC_BERSERK:
-		action = GenerateAction( "Berserk()" );
+		action = GenerateActionFromTemplate("Berserk()");
 		BaseStats[IE_CHECKFORBERSERK]=3;
 		//SetBaseBit(IE_STATE_ID, STATE_BERSERK, true);
 		break;
@@ -7338,8 +7349,7 @@ void Actor::UpdateModalState(ieDword gameTime)
 			BaseStats[IE_CHECKFORBERSERK]--;
 		}
 		if (state & STATE_CONFUSED) {
-			std::string actionString;
-			actionString.reserve(32);
+			const char* actionString;
 			switch (RAND(1, 3)) {
 			case 2:
 				actionString = "RandomWalk()";
@@ -7356,7 +7366,7 @@ void Actor::UpdateModalState(ieDword gameTime)
 				actionString = "NoAction()";
 				break;
 			}
-			Action *action = GenerateAction(actionString);
+			Action *action = GenerateActionFromTemplate(actionString);
 			if (action) {
 				ReleaseCurrentAction();
 				AddActionInFront(action);
@@ -7366,7 +7376,7 @@ void Actor::UpdateModalState(ieDword gameTime)
 		}
 
 		if (Modified[IE_CHECKFORBERSERK] && !LastTarget && SeeAnyOne(false, false) ) {
-			Action *action = GenerateAction( "Berserk()" );
+			Action *action = GenerateActionFromTemplate("Berserk()");
 			if (action) {
 				ReleaseCurrentAction();
 				AddActionInFront(action);
@@ -7695,7 +7705,7 @@ void Actor::NewPath()
 		return;
 	}
 	WalkTo(savedDest, InternalFlags, pathfindingDistance);
-	if (!GetPath()) {
+	if (GetPath().empty()) {
 		IncrementPathTries();
 	}
 }
@@ -51,6 +51,25 @@ void DoorTrigger::SetState(bool open)
 	}
 }
 
+Region DoorTrigger::WallsBBox() const
+{
+	Region bbox;
+	bool empty = true;
+	auto Expand = [&](const WallPolygonGroup& walls) {
+		for (const auto& wp : walls) {
+			if (empty) {
+				bbox = wp->BBox;
+				empty = false;
+			} else {
+				bbox.ExpandToRegion(wp->BBox);
+			}
+		}
+	};
+	Expand(openWalls);
+	Expand(closedWalls);
+	return bbox;
+}
+
 std::shared_ptr<Gem_Polygon> DoorTrigger::StatePolygon() const
 {
 	return StatePolygon(isOpen);
@@ -74,9 +93,30 @@ void Door::ImpedeBlocks(const std::vector<Point> &points, PathMapFlags value) co
 	}
 }
 
+// let the area know which searchmap cells may have changed
+void Door::NotifySearchMapChange() const
+{
+	if (open_ib.empty() && closed_ib.empty()) return;
+
+	Point min = open_ib.empty() ? closed_ib[0] : open_ib[0];
+	Point max = min;
+	auto grow = [&min, &max](const std::vector<Point>& points) {
+		for (const Point& point : points) {
+			min.x = std::min(min.x, point.x);
+			min.y = std::min(min.y, point.y);
+			max.x = std::max(max.x, point.x);
+			max.y = std::max(max.y, point.y);
+		}
+	};
+	grow(open_ib);
+	grow(closed_ib);
+	area->SearchMapChanged(Region(min, Size(max.x - min.x + 1, max.y - min.y + 1)));
+}
+
 void Door::UpdateDoor()
 {
 	doorTrigger.SetState(Flags&DOOR_OPEN);
+	area->WallsChanged(doorTrigger.WallsBBox());
 	outline = doorTrigger.StatePolygon();
 
 	if (outline) {
@@ -102,6 +142,7 @@ void Door::UpdateDoor()
 		ImpedeBlocks(open_ib, PathMapFlags::IMPASSABLE);
 		ImpedeBlocks(closed_ib, pmdflags);
 	}
+	NotifySearchMapChange();
 
 	InfoPoint *ip = area->TMap->GetInfoPoint(LinkedInfo);
 	if (ip) {
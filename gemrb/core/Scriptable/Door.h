@@ -61,6 +61,8 @@ public:
 				std::shared_ptr<Gem_Polygon> closedTrigger, WallPolygonGroup&& closedWall);
 
 	void SetState(bool open);
+	// the map region covered by the walls SetState toggles
+	Region WallsBBox() const;
 
 	std::shared_ptr<Gem_Polygon> StatePolygon() const;
 	std::shared_ptr<Gem_Polygon> StatePolygon(bool open) const;
@@ -98,6 +100,7 @@ public:
 	ieWord ac = 0;
 private:
 	void ImpedeBlocks(const std::vector<Point> &points, PathMapFlags value) const;
+	void NotifySearchMapChange() const;
 	void UpdateDoor();
 	bool BlockedOpen(int Open, int ForceOpen) const;
 public:
@@ -264,8 +264,9 @@ void Scriptable::Update()
 
 void Scriptable::TickScripting()
 {
-	// Stagger script updates.
-	if (Ticks % 16 != globalID % 16) {
+	// Stagger script updates, the ones the scheduler held back retry every tick.
+	bool retry = ScriptDelay > 0;
+	if (!retry && Ticks % 16 != globalID % 16) {
 		return;
 	}
 
@@ -276,22 +277,26 @@ void Scriptable::TickScripting()
 
 	// Dead actors only get one chance to run a new script.
 	if ((InternalFlags & (IF_REALLYDIED | IF_JUSTDIED)) == IF_REALLYDIED) {
+		ScriptDelay = 0;
 		return;
 	}
 
-	ScriptTicks++;
+	if (!retry) {
+		ScriptTicks++;
+	}
 
 	// If no action is running, we've had triggers set recently or we haven't checked recently, do a script update.
 	bool needsUpdate = (!CurrentAction) || (TriggerCountdown > 0) || (IdleTicks > 15);
 
 	// Also do a script update if one was forced..
-	if (InternalFlags & IF_FORCEUPDATE) {
+	bool forced = InternalFlags & IF_FORCEUPDATE;
+	if (forced) {
 		needsUpdate = true;
-		InternalFlags &= ~IF_FORCEUPDATE;
 	}
 	// also force it for on-screen actors
 	Region vp = core->GetGameControl()->Viewport();
-	if (!needsUpdate && vp.PointInside(Pos)) {
+	bool onScreen = vp.PointInside(Pos);
+	if (!needsUpdate && onScreen) {
 		needsUpdate = true;
 	}
 
@@ -301,10 +306,28 @@ void Scriptable::TickScripting()
 	}
 
 	if (!needsUpdate) {
-		IdleTicks++;
+		InternalFlags &= ~IF_FORCEUPDATE;
+		if (!retry) {
+			IdleTicks++;
+		}
+		ScriptDelay = 0;
 		return;
 	}
 
+	// leave everything as it is when deferred, so the update happens as if it was on time
+	ScriptScheduler* scheduler = nullptr;
+	if (Type == ST_ACTOR && area && area->GetScriptScheduler().InTick()) {
+		scheduler = &area->GetScriptScheduler();
+		bool triggered = forced || !triggers.empty() || TriggerCountdown > 0;
+		ScriptScheduler::Priority priority = ScriptScheduler::Classify(static_cast<Actor*>(this), onScreen, triggered);
+		if (!scheduler->Admit(priority, ScriptDelay)) {
+			ScriptDelay++;
+			return;
+		}
+	}
+	ScriptDelay = 0;
+	InternalFlags &= ~IF_FORCEUPDATE;
+
 	if (!triggers.empty()) {
 		TriggerCountdown = 5;
 	}
@@ -314,7 +337,13 @@ void Scriptable::TickScripting()
 		TriggerCountdown--;
 	}
 
+	if (!scheduler) {
+		ExecuteScript(MAX_SCRIPTS);
+		return;
+	}
+	ScriptScheduler::clock::time_point start = ScriptScheduler::clock::now();
 	ExecuteScript(MAX_SCRIPTS);
+	scheduler->Charge(start);
 }
 
 void Scriptable::ExecuteScript(int scriptCount)
@@ -642,11 +671,21 @@ void Scriptable::SetInternalFlag(unsigned int value, BitOp mode)
 void Scriptable::ClearTriggers()
 {
 	triggers.clear();
+	triggerMask.reset();
+}
+
+// a clear bit means there is certainly no such trigger queued
+bool Scriptable::MayHaveTrigger(unsigned short id) const
+{
+	return id >= triggerMask.size() || triggerMask.test(id);
 }
 
 void Scriptable::AddTrigger(TriggerEntry trigger)
 {
 	triggers.push_back(trigger);
+	if (trigger.triggerID < triggerMask.size()) {
+		triggerMask.set(trigger.triggerID);
+	}
 	ImmediateEvent();
 	SetLastTrigger(trigger.triggerID, trigger.param1);
 }
@@ -671,6 +710,8 @@ void Scriptable::SetLastTrigger(ieDword triggerID, ieDword scriptableID)
 
 bool Scriptable::MatchTrigger(unsigned short id, ieDword param) const
 {
+	if (!MayHaveTrigger(id)) return false;
+
 	for (const auto& trigger : triggers) {
 		if (trigger.triggerID != id)
 			continue;
@@ -684,6 +725,8 @@ bool Scriptable::MatchTrigger(unsigned short id, ieDword param) const
 
 bool Scriptable::MatchTriggerWithObject(unsigned short id, const Object *obj, ieDword param) const
 {
+	if (!MayHaveTrigger(id)) return false;
+
 	for (auto& trigger : triggers) {
 		if (trigger.triggerID != id) continue;
 		if (param && trigger.param2 != param) continue;
@@ -696,6 +739,8 @@ bool Scriptable::MatchTriggerWithObject(unsigned short id, const Object *obj, ie
 
 const TriggerEntry *Scriptable::GetMatchingTrigger(unsigned short id, unsigned int notflags) const
 {
+	if (!MayHaveTrigger(id)) return nullptr;
+
 	for (auto& trigger : triggers) {
 		if (trigger.triggerID != id) continue;
 		if (notflags & trigger.flags) continue;
@@ -1905,46 +1950,38 @@ bool Highlightable::PossibleToSeeTrap() const
 
 Movable::~Movable(void)
 {
-	if (path) {
+	if (!path.empty()) {
 		ClearPath(true);
 	}
 }
 
 int Movable::GetPathLength() const
 {
-	const PathListNode *node = GetNextStep(0);
+	const PathNode *node = GetNextStep(0);
 	if (!node) return 0;
 
-	int i = 0;
-	while (node->Next) {
-		i++;
-		node = node->Next;
-	}
-	return i;
+	return int(path.size() - step - 1);
 }
 
-PathListNode *Movable::GetNextStep(int x) const
+const PathNode *Movable::GetNextStep(int x) const
 {
-	if (!step) {
+	if (step == NO_STEP) {
 		error("GetNextStep", "Hit with step = null");
 	}
-	PathListNode *node = step;
-	while(node && x--) {
-		node = node->Next;
-	}
-	return node;
+	size_t idx = step + x;
+	return idx < path.size() ? &path[idx] : nullptr;
 }
 
 Point Movable::GetMostLikelyPosition() const
 {
-	if (!path) {
+	if (path.empty()) {
 		return Pos;
 	}
 
 //actually, sometimes middle path would be better, if
 //we stand in Destination already
 	int halfway = GetPathLength()/2;
-	const PathListNode *node = GetNextStep(halfway);
+	const PathNode *node = GetNextStep(halfway);
 	if (node) {
 		return Map::ConvertCoordFromTile(node->point) + Point(8, 6);
 	}
@@ -2018,11 +2055,11 @@ void Movable::SetAttackMoveChances(const ieWord *amc)
 //this could be used for WingBuffet as well
 void Movable::MoveLine(int steps, orient_t orient)
 {
-	if (path || !steps) {
+	if (!path.empty() || !steps) {
 		return;
 	}
 	// DoStep takes care of stopping on walls if necessary
-	path = area->GetLine(Pos, steps, orient);
+	path.push_back(area->GetLine(Pos, steps, orient));
 }
 
 orient_t Movable::GetNextFace() const
@@ -2053,6 +2090,7 @@ void Movable::BumpAway()
 	bumped = true;
 	bumpBackTries = 0;
 	area->AdjustPositionNavmap(Pos);
+	area->ActorMoved(this);
 }
 
 void Movable::BumpBack()
@@ -2096,7 +2134,7 @@ void Movable::BumpBack()
 void Movable::DoStep(unsigned int walkScale, ieDword time) {
 	// Only bump back if not moving
 	// Actors can be bumped while moving if they are backing off
-	if (!path) {
+	if (path.empty()) {
 		if (IsBumped()) {
 			BumpBack();
 		}
@@ -2109,14 +2147,14 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 		timeStartStep = time;
 		return;
 	}
-	if (!step) {
-		step = path;
+	if (step == NO_STEP) {
+		step = 0;
 		timeStartStep = time;
 		return;
 	}
 
 	if (time > timeStartStep) {
-		Point nmptStep = step->point;
+		Point nmptStep = path[step].point;
 		double dx = nmptStep.x - Pos.x;
 		double dy = nmptStep.y - Pos.y;
 		Map::NormalizeDeltas(dx, dy, double(gamedata->GetStepTime()) / double(walkScale));
@@ -2135,7 +2173,7 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 		bool blocksSearch = BlocksSearchMap();
 		if (actorInTheWay && blocksSearch && actorInTheWay->BlocksSearchMap()) {
 			// Give up instead of bumping if you are close to the goal
-			if (!(step->Next) && PersonalDistance(nmptStep, this) < MAX_OPERATING_DISTANCE) {
+			if (step + 1 == path.size() && PersonalDistance(nmptStep, this) < MAX_OPERATING_DISTANCE) {
 				ClearPath(true);
 				NewOrientation = Orientation;
 				// Do not call ReleaseCurrentAction() since other actions
@@ -2172,11 +2210,11 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 			area->tileProps.PaintSearchMap(Map::ConvertCoordToTile(Pos), circleSize, flag);
 		}
 
-		SetOrientation(step->orient, false);
+		SetOrientation(path[step].orient, false);
 		timeStartStep = time;
 		if (Pos == nmptStep) {
-			if (step->Next) {
-				step = step->Next;
+			if (step + 1 < path.size()) {
+				step++;
 			} else {
 				ClearPath(true);
 				NewOrientation = Orientation;
@@ -2189,35 +2227,27 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 void Movable::AdjustPosition()
 {
 	area->AdjustPosition(Pos);
+	area->ActorMoved(this);
 	ImpedeBumping();
 }
 
 void Movable::AddWayPoint(const Point &Des)
 {
-	if (!path) {
+	if (path.empty()) {
 		WalkTo(Des);
 		return;
 	}
 	Destination = Des;
-	//it is tempting to use 'step' here, as it could
-	//be about half of the current path already
-	PathListNode *endNode = path;
-	while(endNode->Next) {
-		endNode = endNode->Next;
-	}
-	Point p = endNode->point;
+	Point p = path.back().point;
 	area->ClearSearchMapFor(this);
-	PathListNode* path2 = area->FindPath(p, Des, circleSize);
 	// if the waypoint is too close to the current position, no path is generated
-	if (!path2) {
+	if (!area->FindPath(newPath, p, Des, circleSize)) {
 		if (BlocksSearchMap()) {
 			area->BlockSearchMapFor(this);
 		}
 		return;
 	}
-	endNode->Next = path2;
-	//probably it is wise to connect it both ways?
-	path2->Parent = endNode;
+	path.insert(path.end(), newPath.begin(), newPath.end());
 }
 
 // This function is called at each tick if an actor is following another actor
@@ -2225,7 +2255,7 @@ void Movable::AddWayPoint(const Point &Des)
 void Movable::WalkTo(const Point &Des, int distance)
 {
 	// Only rate-limit when moving
-	if ((GetPath() || InMove()) && prevTicks && Ticks < prevTicks + 2) {
+	if ((!path.empty() || InMove()) && prevTicks && Ticks < prevTicks + 2) {
 		return;
 	}
 
@@ -2246,16 +2276,17 @@ void Movable::WalkTo(const Point &Des, int distance)
 	}
 
 	if (BlocksSearchMap()) area->ClearSearchMapFor(this);
-	PathListNode* newPath = area->FindPath(Pos, Des, circleSize, distance, PF_SIGHT | PF_ACTORS_ARE_BLOCKING, actor);
-	if (!newPath && actor && actor->ValidTarget(GA_CAN_BUMP)) {
+	bool found = area->FindPath(newPath, Pos, Des, circleSize, distance, PF_SIGHT | PF_ACTORS_ARE_BLOCKING, actor);
+	if (!found && actor && actor->ValidTarget(GA_CAN_BUMP)) {
 		Log(DEBUG, "WalkTo", "{} re-pathing ignoring actors", fmt::WideToChar{actor->GetShortName()});
-		newPath = area->FindPath(Pos, Des, circleSize, distance, PF_SIGHT, actor);
+		found = area->FindPath(newPath, Pos, Des, circleSize, distance, PF_SIGHT, actor);
 	}
 
-	if (newPath) {
+	if (found) {
 		ClearPath(false);
-		path = newPath;
-		step = path;
+		// swapping keeps both buffers around for the next searches
+		path.swap(newPath);
+		step = 0;
 		HandleAnkhegStance(false);
 	}  else {
 		pathfindingDistance = std::max(circleSize, distance);
@@ -2269,13 +2300,13 @@ void Movable::RunAwayFrom(const Point &Source, int PathLength, bool noBackAway)
 {
 	ClearPath(true);
 	area->ClearSearchMapFor(this);
-	path = area->RunAway(Pos, Source, circleSize, PathLength, !noBackAway, As<Actor>());
+	area->RunAway(path, Pos, Source, circleSize, PathLength, !noBackAway, As<Actor>());
 	HandleAnkhegStance(false);
 }
 
 void Movable::RandomWalk(bool can_stop, bool run)
 {
-	if (path) {
+	if (!path.empty()) {
 		return;
 	}
 	//if not continous random walk, then stops for a while
@@ -2288,7 +2319,7 @@ void Movable::RandomWalk(bool can_stop, bool run)
 		// a 50/50 chance to move or do a spin (including its own wait)
 		if (RAND(1, 2) == 1) {
 			Action *me = ParamCopy(CurrentAction);
-			Action *turnAction = GenerateAction("RandomTurn()");
+			Action *turnAction = GenerateActionFromTemplate("RandomTurn()");
 			// only spin once before relinquishing control back
 			turnAction->int0Parameter = 3;
 			// remove and readd ourselves, so the turning gets a chance to run
@@ -2330,12 +2361,12 @@ void Movable::RandomWalk(bool can_stop, bool run)
 
 	//the 5th parameter is controlling the orientation of the actor
 	//0 - back away, 1 - face direction
-	path = area->RandomWalk(Pos, circleSize, maxWalkDistance ? maxWalkDistance : 5, As<Actor>());
+	bool found = area->RandomWalk(path, Pos, circleSize, maxWalkDistance ? maxWalkDistance : 5, As<Actor>());
 	if (BlocksSearchMap()) {
 		area->BlockSearchMapFor(this);
 	}
-	if (path) {
-		Destination = path->point;
+	if (found) {
+		Destination = path.front().point;
 	} else {
 		randomWalkCounter = 0;
 		WalkTo(HomeLocation);
@@ -2350,6 +2381,7 @@ void Movable::MoveTo(const Point &Des)
 	Pos = Des;
 	oldPos = Des;
 	Destination = Des;
+	area->ActorMoved(this);
 	if (BlocksSearchMap()) {
 		area->BlockSearchMapFor(this);
 	}
@@ -2377,14 +2409,8 @@ void Movable::ClearPath(bool resetDestination)
 		HandleAnkhegStance(true);
 		InternalFlags &= ~IF_NORETICLE;
 	}
-	PathListNode* thisNode = path;
-	while (thisNode) {
-		PathListNode* nextNode = thisNode->Next;
-		delete thisNode;
-		thisNode = nextNode;
-	}
-	path = nullptr;
-	step = nullptr;
+	path.clear();
+	step = NO_STEP;
 	//don't call ReleaseCurrentAction
 }
 
@@ -2393,7 +2419,7 @@ void Movable::HandleAnkhegStance(bool emerge)
 {
 	const Actor* actor = As<Actor>();
 	int nextStance = emerge ? IE_ANI_EMERGE : IE_ANI_HIDE;
-	if (actor && path && StanceID != nextStance && actor->GetAnims()->GetAnimType() == IE_ANI_TWO_PIECE) {
+	if (actor && !path.empty() && StanceID != nextStance && actor->GetAnims()->GetAnimType() == IE_ANI_TWO_PIECE) {
 		SetStance(nextStance);
 		SetWait(15); // both stances have 15 frames, at 15 fps
 	}
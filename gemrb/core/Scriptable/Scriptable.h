@@ -25,11 +25,15 @@
 #include "ie_cursors.h"
 
 #include "CharAnimations.h"
+#include "PathFinder.h"
+#include "RingBuffer.h"
 #include "Variables.h"
 
+#include <bitset>
 #include <list>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace GemRB {
 
@@ -44,7 +48,6 @@ class InfoPoint;
 class Map;
 class Movable;
 class Object;
-struct PathListNode;
 class Projectile;
 class Scriptable;
 class Selectable;
@@ -206,7 +209,8 @@ enum {
 	trigger_namelessbitthedust = 0xab, // pst
 	trigger_failedtoopen = 0xaf, // pst
 	trigger_tookdamage = 0xcc, // bg2
-	trigger_walkedtotrigger = 0xd6 // bg2
+	trigger_walkedtotrigger = 0xd6, // bg2
+	trigger_idcount = 0x100 // upper bound of the ids above, for the trigger mask
 };
 
 // flags for TriggerEntry
@@ -238,12 +242,14 @@ private:
 	std::map<ieDword,ieDword> script_timers;
 	ieDword globalID = 0;
 protected: //let Actor access this
-	std::list<TriggerEntry> triggers;
+	// kept in arrival order; triggerMask has a bit set for every id in there
+	std::vector<TriggerEntry> triggers;
+	std::bitset<trigger_idcount> triggerMask;
 	Map *area = nullptr;
 	ieVariable scriptName;
 	ieDword InternalFlags = 0; // for triggers
 	ResRef Dialog;
-	std::list< Action*> actionQueue;
+	RingBuffer<Action*> actionQueue;
 	Action* CurrentAction = nullptr;
 
 	// Variables for overhead text.
@@ -271,6 +277,8 @@ public:
 	ieDword AuraCooldown = 0;
 	// The countdown for forced activation by triggers.
 	ieDword TriggerCountdown = 0;
+	// The number of ticks the script scheduler has been holding back a due update.
+	ieDword ScriptDelay = 0;
 
 	Variables* locals;
 	ScriptableType Type = ST_ACTOR;
@@ -382,6 +390,7 @@ public:
 	//true condition (whole triggerblock returned true)
 	void ClearTriggers();
 	void AddTrigger(TriggerEntry trigger);
+	bool MayHaveTrigger(unsigned short id) const;
 	void SetLastTrigger(ieDword triggerID, ieDword scriptableID);
 	bool MatchTrigger(unsigned short id, ieDword param = 0) const;
 	bool MatchTriggerWithObject(short unsigned int id, const Object *obj, ieDword param = 0) const;
@@ -489,8 +498,10 @@ private: //these seem to be sensitive, so get protection
 	orient_t NewOrientation = S;
 	ieWord AttackMovements[3] = { 100, 0 , 0 };
 
-	PathListNode* path = nullptr; // whole path
-	PathListNode* step = nullptr; // actual step
+	static constexpr size_t NO_STEP = size_t(-1);
+	Path path; // whole path
+	Path newPath; // searched into first, so a failed search keeps the current path
+	size_t step = NO_STEP; // actual step, an index into path
 	unsigned int prevTicks = 0;
 	int bumpBackTries = 0;
 	bool pathAbandoned = false;
@@ -528,18 +539,18 @@ public:
 	void BumpAway();
 	void BumpBack();
 	inline bool IsBumped() const { return bumped; }
-	PathListNode *GetNextStep(int x) const;
-	inline PathListNode *GetPath() const { return path; };
+	const PathNode *GetNextStep(int x) const;
+	inline const Path& GetPath() const { return path; };
 	inline int GetPathTries() const	{ return pathTries; }
 	inline void IncrementPathTries() { pathTries++; }
 	inline void ResetPathTries() { pathTries = 0; }
 	int GetPathLength() const;
 //inliners to protect data consistency
-	inline PathListNode * GetStep() {
-		if (!step) {
+	inline const PathNode *GetStep() {
+		if (step == NO_STEP) {
 			DoStep((unsigned int) ~0);
 		}
-		return step;
+		return step < path.size() ? &path[step] : nullptr;
 	}
 
 	inline bool IsMoving() const {
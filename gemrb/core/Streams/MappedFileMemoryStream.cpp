@@ -27,15 +27,13 @@ namespace GemRB {
 
 MappedFileMemoryStream::MappedFileMemoryStream(const std::string& fileName)
 	: MemoryStream(fileName.c_str(), nullptr, 0),
-		fileHandle(nullptr),
-		fileOpened(false),
-		fileMapped(false)
+		mapping(std::make_shared<Mapping>())
 {
 #ifdef WIN32
 	TCHAR t_name[MAX_PATH] = {0};
 	mbstowcs(t_name, fileName.c_str(), MAX_PATH - 1);
 
-	this->fileHandle =
+	mapping->fileHandle =
 		CreateFile(
 			t_name,
 			GENERIC_READ,
@@ -45,42 +43,59 @@ MappedFileMemoryStream::MappedFileMemoryStream(const std::string& fileName)
 			FILE_ATTRIBUTE_NORMAL,
 			nullptr
 		);
-	this->fileOpened = fileHandle != INVALID_HANDLE_VALUE;
+	mapping->fileOpened = mapping->fileHandle != INVALID_HANDLE_VALUE;
 
-	if (fileOpened) {
+	if (mapping->fileOpened) {
 		LARGE_INTEGER fileSize;
-		GetFileSizeEx(fileHandle, &fileSize);
+		GetFileSizeEx(mapping->fileHandle, &fileSize);
 		assert(fileSize.QuadPart <= ULONG_MAX);
-		size = static_cast<strpos_t>(fileSize.QuadPart);
+		mapping->size = static_cast<strpos_t>(fileSize.QuadPart);
 	}
 #else
-	this->fileHandle = fopen(fileName.c_str(), "rb");
-	this->fileOpened = fileHandle != nullptr;
+	mapping->fileHandle = fopen(fileName.c_str(), "rb");
+	mapping->fileOpened = mapping->fileHandle != nullptr;
 
-	if (fileOpened) {
+	if (mapping->fileOpened) {
 		struct stat statData{};
-		int ret = fstat(fileno(static_cast<FILE*>(fileHandle)), &statData);
+		int ret = fstat(fileno(static_cast<FILE*>(mapping->fileHandle)), &statData);
 		assert(ret != -1);
-		this->size = statData.st_size;
+		mapping->size = statData.st_size;
 	}
 #endif
 
-	if (fileOpened) {
-		this->data = static_cast<char*>(readonly_mmap(fileHandle));
-		this->fileMapped = data != nullptr;
+	if (mapping->fileOpened) {
+		mapping->data = readonly_mmap(mapping->fileHandle);
+		mapping->fileMapped = mapping->data != nullptr;
 	}
+
+	this->size = mapping->size;
+	this->data = static_cast<char*>(mapping->data);
 }
 
+MappedFileMemoryStream::MappedFileMemoryStream(const char* fileName, std::shared_ptr<Mapping> mapping)
+	: MemoryStream(fileName, mapping->data, mapping->size),
+		mapping(std::move(mapping))
+{}
+
 bool MappedFileMemoryStream::isOk() const {
-	return fileOpened && fileMapped;
+	return mapping->fileOpened && mapping->fileMapped;
 }
 
 DataStream* MappedFileMemoryStream::Clone() const noexcept {
-	return new MappedFileMemoryStream(originalfile);
+	// no need to map the file again
+	return new MappedFileMemoryStream(originalfile, mapping);
+}
+
+DataStream* MappedFileMemoryStream::Slice(strpos_t startPos, strpos_t length) const {
+	if (!mapping->fileMapped || startPos > size || length > size - startPos) {
+		return nullptr;
+	}
+
+	return new MemoryViewStream(originalfile, data + startPos, length, mapping);
 }
 
 strret_t MappedFileMemoryStream::Read(void* dest, strpos_t length) {
-	if (!fileMapped) {
+	if (!mapping->fileMapped) {
 		return Error;
 	}
 
@@ -88,7 +103,7 @@ strret_t MappedFileMemoryStream::Read(void* dest, strpos_t length) {
 }
 
 stroff_t MappedFileMemoryStream::Seek(stroff_t pos, strpos_t startPos) {
-	if (!fileMapped) {
+	if (!mapping->fileMapped) {
 		return InvalidPos;
 	}
 
@@ -100,12 +115,15 @@ strret_t MappedFileMemoryStream::Write(const void*, strpos_t) {
 }
 
 MappedFileMemoryStream::~MappedFileMemoryStream() {
+	// the mapping is released together with the last user
+	this->data = nullptr;
+}
+
+MappedFileMemoryStream::Mapping::~Mapping() {
 	if (fileMapped) {
 		munmap(data, size);
 	}
 
-	this->data = nullptr;
-
 	if (fileOpened) {
 #ifdef WIN32
 		CloseHandle(fileHandle);
@@ -29,6 +29,8 @@ class GEM_EXPORT MappedFileMemoryStream : public MemoryStream {
 		~MappedFileMemoryStream() override;
 
 		bool isOk() const;
+		/** Returns a stream viewing a part of the mapping directly, without copying */
+		DataStream* Slice(strpos_t startPos, strpos_t length) const;
 
 		strret_t Read(void* dest, strpos_t len) override;
 		strret_t Seek(stroff_t pos, strpos_t startPos) override;
@@ -36,9 +38,19 @@ class GEM_EXPORT MappedFileMemoryStream : public MemoryStream {
 		DataStream* Clone() const noexcept override;
 
 	private:
-		void *fileHandle;
-		bool fileOpened;
-		bool fileMapped;
+		// the mapping is shared with clones and slices, so it lives on until the last one is gone
+		struct Mapping {
+			void *fileHandle = nullptr;
+			void *data = nullptr;
+			strpos_t size = 0;
+			bool fileOpened = false;
+			bool fileMapped = false;
+
+			~Mapping();
+		};
+		std::shared_ptr<Mapping> mapping;
+
+		MappedFileMemoryStream(const char* fileName, std::shared_ptr<Mapping> mapping);
 };
 
 }
@@ -99,4 +99,24 @@ stroff_t MemoryStream::Seek(stroff_t newpos, strpos_t type)
 	return 0;
 }
 
+MemoryViewStream::MemoryViewStream(const char *name, const char* data, strpos_t size, std::shared_ptr<const void> owner)
+	: MemoryStream(name, const_cast<char*>(data), size), owner(std::move(owner))
+{}
+
+MemoryViewStream::~MemoryViewStream()
+{
+	// not ours to free
+	data = nullptr;
+}
+
+DataStream* MemoryViewStream::Clone() const noexcept
+{
+	return new MemoryViewStream(originalfile, data, size, owner);
+}
+
+strret_t MemoryViewStream::Write(const void* /*src*/, strpos_t /*length*/)
+{
+	return Error;
+}
+
 }
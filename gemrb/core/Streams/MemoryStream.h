@@ -25,6 +25,8 @@
 
 #include "exports.h"
 
+#include <memory>
+
 namespace GemRB {
 
 class GEM_EXPORT MemoryStream : public DataStream
@@ -41,6 +43,20 @@ public:
 	strret_t Seek(stroff_t pos, strpos_t startpos) override;
 };
 
+// read-only view into memory owned by someone else (eg. a file mapping),
+// the owner is kept alive for as long as there are views into it
+class GEM_EXPORT MemoryViewStream : public MemoryStream
+{
+private:
+	std::shared_ptr<const void> owner;
+public:
+	MemoryViewStream(const char *name, const char* data, strpos_t size, std::shared_ptr<const void> owner);
+	~MemoryViewStream() override;
+	DataStream* Clone() const noexcept override;
+
+	strret_t Write(const void* src, strpos_t length) override;
+};
+
 }
 
 #endif
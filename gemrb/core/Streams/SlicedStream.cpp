@@ -21,6 +21,9 @@
 #include "SlicedStream.h"
 
 #include "MemoryStream.h"
+#if defined(SUPPORTS_MEMSTREAM)
+#include "MappedFileMemoryStream.h"
+#endif
 
 #include "errors.h"
 
@@ -99,6 +102,17 @@ stroff_t SlicedStream::Seek(stroff_t newpos, strpos_t type)
 
 DataStream* SliceStream(DataStream* str, strpos_t startpos, strpos_t size, bool preservepos)
 {
+#if defined(SUPPORTS_MEMSTREAM)
+	// the data is already in memory, so just point into it
+	const MappedFileMemoryStream* mapped = dynamic_cast<const MappedFileMemoryStream*>(str);
+	if (mapped) {
+		DataStream* view = mapped->Slice(startpos, size);
+		if (view) {
+			return view;
+		}
+	}
+#endif
+
 	if (size <= 16384) {
 		// small (or empty) substream, just read it into a buffer instead of expensive file I/O
 		strpos_t oldpos;
@@ -80,6 +80,7 @@ Door* TileMap::AddDoor(const ResRef& ID, const ieVariable& Name, unsigned int Fl
 	door->SetName( ID );
 	door->SetScriptName( Name );
 	doors.push_back( door );
+	globalIDs[door->GetGlobalID()] = door;
 	return door;
 }
 
@@ -168,6 +169,7 @@ void TileMap::DrawOverlays(const Region& viewport, bool rain, BlitFlags flags)
 void TileMap::AddContainer(Container *c)
 {
 	containers.push_back(c);
+	globalIDs[c->GetGlobalID()] = c;
 }
 
 Container* TileMap::GetContainer(unsigned int idx) const
@@ -250,6 +252,7 @@ int TileMap::CleanupContainer(Container *container)
 	for (size_t i = 0; i < containers.size(); i++) {
 		if (containers[i]==container) {
 			containers.erase(containers.begin()+i);
+			globalIDs.erase(container->GetGlobalID());
 			delete container;
 			return 1;
 		}
@@ -286,9 +289,19 @@ InfoPoint* TileMap::AddInfoPoint(const ieVariable& Name, unsigned short Type, co
 		ip->BBox = outline->BBox;
 	//ip->Active = true; //set active on creation
 	infoPoints.push_back( ip );
+	globalIDs[ip->GetGlobalID()] = ip;
 	return ip;
 }
 
+Scriptable* TileMap::GetScriptableByGlobalID(ieDword globalID) const
+{
+	auto it = globalIDs.find(globalID);
+	if (it == globalIDs.end()) {
+		return nullptr;
+	}
+	return it->second;
+}
+
 //if detectable is set, then only detectable infopoints will be returned
 InfoPoint* TileMap::GetInfoPoint(const Point &p, bool skipSilent) const
 {
@@ -26,6 +26,8 @@
 #include "Scriptable/Door.h"
 #include "TileOverlay.h"
 
+#include <unordered_map>
+
 namespace GemRB {
 
 //special container types
@@ -77,6 +79,9 @@ public:
 	InfoPoint* AdjustNearestTravel(Point &p);
 	size_t GetInfoPointCount() const { return infoPoints.size(); }
 
+	// finds any of the doors, containers and infopoints
+	Scriptable* GetScriptableByGlobalID(ieDword globalID) const;
+
 	TileObject* AddTile(const ResRef& ID, const ieVariable& Name, unsigned int Flags,
 		unsigned short* openindices, int opencount,unsigned short* closeindices, int closecount);
 	TileObject* GetTile(unsigned int idx);
@@ -97,6 +102,7 @@ private:
 	std::vector< Container*> containers;
 	std::vector< InfoPoint*> infoPoints;
 	std::vector< TileObject*> tiles;
+	std::unordered_map<ieDword, Scriptable*> globalIDs;
 };
 
 }
@@ -63,7 +63,7 @@ inline bool Variables::MyCompareKey(const key_t& key, key_t str) const
 	return s == end;
 }
 
-inline unsigned int Variables::MyHashKey(const key_t& key) const
+unsigned int Variables::HashKey(const key_t& key)
 {
 	assert(key.c_str());
 
@@ -250,7 +250,17 @@ Variables::MyAssoc* Variables::GetAssocAt(const key_t& key, unsigned int& nHash)
 		return nullptr;
 	}
 
-	nHash = MyHashKey( key ) % m_nHashTableSize;
+	return GetAssocAtHashed(key, HashKey(key), nHash);
+}
+
+Variables::MyAssoc* Variables::GetAssocAtHashed(const key_t& key, unsigned int hash, unsigned int& nHash) const
+{
+	if (key.empty() || key.c_str() == nullptr) {
+		nHash = 0;
+		return nullptr;
+	}
+
+	nHash = hash % m_nHashTableSize;
 
 	if (m_pHashTable == NULL) {
 		return NULL;
@@ -324,6 +334,19 @@ bool Variables::Lookup(const key_t& key, ieDword& rValue) const
 	return true;
 }
 
+bool Variables::LookupHashed(const key_t& key, unsigned int hash, ieDword& rValue) const
+{
+	unsigned int nHash;
+	assert(m_type==GEM_VARIABLES_INT);
+	const Variables::MyAssoc* pAssoc = GetAssocAtHashed(key, hash, nHash);
+	if (pAssoc == NULL) {
+		return false;
+	} // not in map
+
+	rValue = pAssoc->Value.nValue;
+	return true;
+}
+
 bool Variables::HasKey(const key_t& key) const
 {
 	unsigned int nHash;
@@ -398,6 +421,13 @@ void Variables::SetAt(const key_t& key, void* value)
 
 
 void Variables::SetAt(const key_t& key, ieDword value, bool nocreate)
+{
+	if (!key.c_str()) return;
+
+	SetAtHashed(key, HashKey(key), value, nocreate);
+}
+
+void Variables::SetAtHashed(const key_t& key, unsigned int hash, ieDword value, bool nocreate)
 {
 	unsigned int nHash;
 	Variables::MyAssoc* pAssoc;
@@ -405,7 +435,7 @@ void Variables::SetAt(const key_t& key, ieDword value, bool nocreate)
 	if (!key.c_str()) return;
 
 	assert( m_type == GEM_VARIABLES_INT );
-	if (( pAssoc = GetAssocAt( key, nHash ) ) == NULL) {
+	if (( pAssoc = GetAssocAtHashed( key, hash, nHash ) ) == NULL) {
 		if (nocreate) {
 			Log(WARNING, "Variables", "Cannot create new variable: {}", key);
 			return;
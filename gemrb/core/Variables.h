@@ -91,6 +91,12 @@ public:
 		return m_nCount == 0;
 	}
 
+	// the hash only depends on the key, so callers that look up the same
+	// name over and over can compute it once and use the Hashed variants
+	static unsigned int HashKey(const key_t&);
+	bool LookupHashed(const key_t&, unsigned int hash, ieDword& rValue) const;
+	void SetAtHashed(const key_t&, unsigned int hash, ieDword newValue, bool nocreate = false);
+
 	bool Lookup(const key_t&, ieDword& rValue) const;
 	bool Lookup(const key_t&, String& dest) const;
 	bool Lookup(const key_t&, std::string& dest) const;
@@ -152,9 +158,9 @@ protected:
 	Variables::MyAssoc* NewAssoc(const key_t&);
 	void FreeAssoc(Variables::MyAssoc*);
 	Variables::MyAssoc* GetAssocAt(const key_t&, unsigned int&) const;
+	Variables::MyAssoc* GetAssocAtHashed(const key_t&, unsigned int hash, unsigned int& nHash) const;
 	inline bool MyCopyKey(char*& dest, const key_t&) const;
 	inline bool MyCompareKey(const key_t&, key_t str) const;
-	inline unsigned int MyHashKey(const key_t&) const;
 	
 	void SetAtCString(const key_t&, const char* newValue);
 };
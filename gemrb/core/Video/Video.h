@@ -161,6 +161,16 @@ public:
 	virtual bool TouchInputEnabled() = 0;
 	virtual bool CanDrawRawGeometry() const { return false; }
 
+	struct FrameStats {
+		size_t textures = 0; // alive at the end of the frame
+		size_t drawCalls = 0;
+		size_t batchBreaks = 0; // sprite batches drawn early because the state changed
+	};
+	// the counters of the last finished frame, drivers that don't keep them report zeros
+	virtual FrameStats GetFrameStats() const { return {}; }
+	// whether BlitVideoBuffer with BlitFlags::NONE replaces the target pixels, alpha included
+	virtual bool CanCopyVideoBuffers() const { return false; }
+
 	virtual Holder<Sprite2D> CreateSprite(const Region&, void* pixels, const PixelFormat&) = 0;
 	
 	void BlitSprite(const Holder<Sprite2D>& spr, Point p,
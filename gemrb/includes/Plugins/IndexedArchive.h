@@ -32,6 +32,8 @@ class GEM_PLUGIN_EXPORT IndexedArchive : public Plugin {
 public:
 	virtual int OpenArchive(const char* filename) = 0;
 	virtual DataStream* GetStream(unsigned long Resource, unsigned long Type) = 0;
+	/** Checks if the archive has an entry for the locator, without touching its data */
+	virtual bool HasLocator(unsigned long Resource, unsigned long Type) const = 0;
 };
 
 }
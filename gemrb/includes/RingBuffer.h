@@ -0,0 +1,113 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace GemRB {
+
+// A double ended queue in a single growing array. Unlike std::deque and
+// std::list it only allocates when it has to grow, so a queue that is
+// filled and drained all the time settles down without touching the heap.
+template <typename T>
+class RingBuffer {
+private:
+	std::vector<T> items; // the capacity is always 0 or a power of two
+	size_t head = 0;
+	size_t count = 0;
+
+	size_t Index(size_t pos) const
+	{
+		return (head + pos) & (items.size() - 1);
+	}
+
+	void Grow()
+	{
+		std::vector<T> grown(items.empty() ? 8 : items.size() * 2);
+		for (size_t i = 0; i < count; ++i) {
+			grown[i] = std::move(items[Index(i)]);
+		}
+		items.swap(grown);
+		head = 0;
+	}
+
+public:
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+
+	T& front()
+	{
+		assert(count);
+		return items[head];
+	}
+	const T& front() const
+	{
+		assert(count);
+		return items[head];
+	}
+
+	T& operator[](size_t pos)
+	{
+		assert(pos < count);
+		return items[Index(pos)];
+	}
+	const T& operator[](size_t pos) const
+	{
+		assert(pos < count);
+		return items[Index(pos)];
+	}
+
+	void push_back(T item)
+	{
+		if (count == items.size()) Grow();
+		items[Index(count)] = std::move(item);
+		count++;
+	}
+
+	void push_front(T item)
+	{
+		if (count == items.size()) Grow();
+		head = (head + items.size() - 1) & (items.size() - 1);
+		items[head] = std::move(item);
+		count++;
+	}
+
+	void pop_front()
+	{
+		assert(count);
+		items[head] = T();
+		head = Index(1);
+		count--;
+	}
+
+	void clear()
+	{
+		while (count) pop_front();
+		head = 0;
+	}
+};
+
+}
+
+#endif
@@ -32,6 +32,8 @@
 
 using namespace GemRB;
 
+const ieDword BIFImporter::NoEntry;
+
 BIFImporter::~BIFImporter(void)
 {
 	delete stream;
@@ -155,26 +157,35 @@ int BIFImporter::OpenArchive(const char* path)
 	return ReadBIF();
 }
 
+ieDword BIFImporter::FindEntry(unsigned long Resource, unsigned long Type) const
+{
+	if (Type == IE_TIS_CLASS_ID) {
+		ieDword srcResLoc = (Resource & 0xFC000) >> 14;
+		return srcResLoc < tileIndex.size() ? tileIndex[srcResLoc] : NoEntry;
+	}
+
+	ieDword srcResLoc = Resource & 0x3FFF;
+	return srcResLoc < fileIndex.size() ? fileIndex[srcResLoc] : NoEntry;
+}
+
+bool BIFImporter::HasLocator(unsigned long Resource, unsigned long Type) const
+{
+	return FindEntry(Resource, Type) != NoEntry;
+}
+
 DataStream* BIFImporter::GetStream(unsigned long Resource, unsigned long Type)
 {
+	ieDword i = FindEntry(Resource, Type);
+	if (i == NoEntry) {
+		return NULL;
+	}
+
 	if (Type == IE_TIS_CLASS_ID) {
-		unsigned int srcResLoc = Resource & 0xFC000;
-		for (unsigned int i = 0; i < tentcount; i++) {
-			if (( tentries[i].resLocator & 0xFC000 ) == srcResLoc) {
-				return SliceStream( stream, tentries[i].dataOffset,
-							tentries[i].tileSize * tentries[i].tilesCount );
-			}
-		}
-	} else {
-		ieDword srcResLoc = Resource & 0x3FFF;
-		for (ieDword i = 0; i < fentcount; i++) {
-			if (( fentries[i].resLocator & 0x3FFF ) == srcResLoc) {
-				return SliceStream( stream, fentries[i].dataOffset,
-							fentries[i].fileSize );
-			}
-		}
+		return SliceStream( stream, tentries[i].dataOffset,
+					tentries[i].tileSize * tentries[i].tilesCount );
 	}
-	return NULL;
+	return SliceStream( stream, fentries[i].dataOffset,
+				fentries[i].fileSize );
 }
 
 int BIFImporter::ReadBIF()
@@ -207,6 +218,18 @@ int BIFImporter::ReadBIF()
 		stream->ReadWord(tentries[i].type);
 		stream->ReadWord(tentries[i].u1);
 	}
+
+	// build the locator indices; the first entry wins, like the old linear search did
+	fileIndex.assign(0x4000, NoEntry);
+	for (ieDword i = 0; i < fentcount; i++) {
+		ieDword& slot = fileIndex[fentries[i].resLocator & 0x3FFF];
+		if (slot == NoEntry) slot = i;
+	}
+	tileIndex.assign(0x40, NoEntry);
+	for (ieDword i = 0; i < tentcount; i++) {
+		ieDword& slot = tileIndex[(tentries[i].resLocator & 0xFC000) >> 14];
+		if (slot == NoEntry) slot = i;
+	}
 	return GEM_OK;
 }
 
@@ -27,6 +27,8 @@
 
 #include "Streams/DataStream.h"
 
+#include <vector>
+
 namespace GemRB {
 
 struct FileEntry {
@@ -53,6 +55,11 @@ private:
 	ieDword fentcount = 0;
 	ieDword tentcount = 0;
 	DataStream* stream = nullptr;
+	// locator -> entry index lookups, filled by ReadBIF
+	// files are indexed by the low 14 bits, tilesets by the 6 bits above them
+	static const ieDword NoEntry = 0xffffffff;
+	std::vector<ieDword> fileIndex;
+	std::vector<ieDword> tileIndex;
 public:
 	BIFImporter() noexcept = default;
 	BIFImporter(const BIFImporter&) = delete;
@@ -60,7 +67,9 @@ public:
 	BIFImporter& operator=(const BIFImporter&) = delete;
 	int OpenArchive(const char* filename) override;
 	DataStream* GetStream(unsigned long Resource, unsigned long Type) override;
+	bool HasLocator(unsigned long Resource, unsigned long Type) const override;
 private:
+	ieDword FindEntry(unsigned long Resource, unsigned long Type) const;
 	static DataStream* DecompressBIF(DataStream* compressed, const char* path);
 	static DataStream* DecompressBIFC(DataStream* compressed, const char* path);
 	int ReadBIF();
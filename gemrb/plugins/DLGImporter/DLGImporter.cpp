@@ -157,11 +157,12 @@ Condition* DLGImporter::GetCondition(const char* string) const
 		if (!trigger) {
 			Log(WARNING, "DLGImporter", "Can't compile trigger: {}", lines[i]);
 		} else {
-			condition->triggers.push_back(trigger);
+			condition->AddTrigger(trigger);
 		}
 		free( lines[i] );
 	}
 	free( lines );
+	condition->Compile();
 	return condition;
 }
 
@@ -4674,8 +4674,8 @@ int fx_cast_spell (Scriptable* Owner, Actor* target, Effect* fx)
 	if (fx->Parameter2 == 0 || target->Type == ST_CONTAINER) {
 		// no deplete, no interrupt, caster or provided level
 		// ForceSpell doesn't have a RES variant, so there's more work
-		std::string tmp = fmt::format("ForceSpell([-1],{})", ResolveSpellNumber(fx->Resource));
-		Action *forceSpellAction = GenerateActionDirect(std::move(tmp), target);
+		Action *forceSpellAction = GenerateActionDirect("ForceSpell([-1],0)", target);
+		forceSpellAction->int0Parameter = ResolveSpellNumber(fx->Resource);
 		if (fx->Parameter1 != 0) {
 			// override casting level
 			forceSpellAction->int1Parameter = fx->Parameter1;
@@ -4716,8 +4716,8 @@ int fx_cast_spell_point (Scriptable* Owner, Actor* /*target*/, Effect* fx)
 	if (fx->Parameter2 == 0) {
 		// no deplete, no interrupt, caster or provided level
 		// ForceSpellPoint doesn't have a RES variant, so there's more work
-		std::string tmp = fmt::format("ForceSpellPoint([{}.{}],{})", fx->Pos.x, fx->Pos.y, ResolveSpellNumber(fx->Resource));
-		Action *forceSpellAction = GenerateAction(std::move(tmp));
+		Action *forceSpellAction = GenerateActionAt("ForceSpellPoint([0.0],0)", fx->Pos);
+		forceSpellAction->int0Parameter = ResolveSpellNumber(fx->Resource);
 		if (fx->Parameter1 != 0) {
 			// override casting level
 			forceSpellAction->int1Parameter = fx->Parameter1;
@@ -6445,7 +6445,7 @@ int fx_cast_spell_on_condition (Scriptable* Owner, Actor* target, Effect* fx)
 		break;
 	case COND_DIED_ANY:
 		// Died([ANYONE])
-		condition = GameScript::EvaluateString(target, "Died([ANYONE])");
+		condition = GameScript::EvaluateTemplate(target, "Died([ANYONE])");
 		per_round = false;
 		break;
 	case COND_TURNEDBY:
@@ -48,6 +48,7 @@
 #include "Video/Video.h"
 #include "WorldMap.h"
 #include "GameScript/GSUtils.h" //checkvariable
+#include "GameScript/ScriptProfiler.h"
 #include "GUI/Button.h"
 #include "GUI/Console.h"
 #include "GUI/EventMgr.h"
@@ -4595,6 +4596,39 @@ static PyObject* GemRB_GetSaveGames(PyObject * /*self*/, PyObject * /*args*/)
 	return MakePyList<SaveGame>(core->GetSaveGameIterator()->GetSaveGames());
 }
 
+PyDoc_STRVAR( GemRB_GetScriptProfile__doc,
+"===== GetScriptProfile =====\n\
+\n\
+**Prototype:** GemRB.GetScriptProfile ([Count, Reset])\n\
+\n\
+**Description:** Returns a report of the scripts, areas, response blocks, \n\
+triggers and actions that took the most time so far. The data is only \n\
+gathered while the script profiling debug mode (2048) is on.\n\
+\n\
+**Parameters:**\n\
+  * Count - the number of entries listed per category, 20 by default\n\
+  * Reset - if true, the gathered data is dropped afterwards\n\
+\n\
+**Return value:** string\n\
+\n\
+**Examples:**\n\
+\n\
+    print (GemRB.GetScriptProfile (10))"
+);
+
+static PyObject* GemRB_GetScriptProfile(PyObject * /*self*/, PyObject* args)
+{
+	int count = 20;
+	int reset = 0;
+	PARSE_ARGS( args,  "|ii", &count, &reset );
+
+	std::string report = GameScript::ProfileReport(std::max(count, 0));
+	if (reset) {
+		ScriptProfiler::Get().Reset();
+	}
+	return PyString_FromStringObj(report);
+}
+
 PyDoc_STRVAR( GemRB_DeleteSaveGame__doc,
 "===== DeleteSaveGame =====\n\
 \n\
@@ -10496,7 +10530,7 @@ static PyObject* GemRB_LeaveParty(PyObject * /*self*/, PyObject* args)
 		}
 		if(actor->GetBase(IE_HITPOINTS) > 0) {
 			actor->Stop();
-			actor->AddAction( GenerateAction("Dialogue([PC])") );
+			actor->AddAction( GenerateActionFromTemplate("Dialogue([PC])") );
 		}
 	}
 	game->LeaveParty (actor);
@@ -13221,6 +13255,7 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetPlayerString, METH_VARARGS),
 	METHOD(GetRumour, METH_VARARGS),
 	METHOD(GetSaveGames, METH_VARARGS),
+	METHOD(GetScriptProfile, METH_VARARGS),
 	METHOD(GetSelectedSize, METH_NOARGS),
 	METHOD(GetSelectedActors, METH_NOARGS),
 	METHOD(GetString, METH_VARARGS),
@@ -26,8 +26,18 @@
 #include "ResourceDesc.h"
 #include "Streams/FileStream.h"
 
+#include <chrono>
+
 using namespace GemRB;
 
+KEYImporter::~KEYImporter()
+{
+	if (archiveHits || archiveMisses) {
+		Log(DEBUG, "KEYImporter", "Archive pool: {} hits, {} misses, {}us spent opening archives",
+			archiveHits, archiveMisses, archiveOpenTime);
+	}
+}
+
 static char* AddCBF(const char *file)
 {
 	assert(strnlen(file, _MAX_PATH/2) < _MAX_PATH/2);
@@ -212,9 +222,14 @@ DataStream* KEYImporter::GetStream(const ResRef& resname, ieWord type)
 		return NULL;
 	}
 
-	PluginHolder<IndexedArchive> ai = MakePluginHolder<IndexedArchive>(IE_BIF_CLASS_ID);
-	if (ai->OpenArchive( biffiles[bifnum].path ) == GEM_ERROR) {
-		Log(ERROR, "KEYImporter", "Cannot open archive {}", biffiles[bifnum].path);
+	std::lock_guard<std::mutex> lock(archiveLock);
+	IndexedArchive* ai = GetArchive(bifnum);
+	if (!ai) {
+		return NULL;
+	}
+	if (!ai->HasLocator(*ResLocator, type)) {
+		Log(ERROR, "KEYImporter", "Locator {:#x} for {} not found in {}!",
+			*ResLocator, resname, biffiles[bifnum].name);
 		return NULL;
 	}
 
@@ -230,6 +245,47 @@ DataStream* KEYImporter::GetStream(const ResRef& resname, ieWord type)
 	return NULL;
 }
 
+IndexedArchive* KEYImporter::GetArchive(unsigned int bifnum)
+{
+	archiveUses++;
+	for (auto& cached : openArchives) {
+		if (cached.bifnum == bifnum) {
+			cached.lastUsed = archiveUses;
+			archiveHits++;
+			return cached.plugin.get();
+		}
+	}
+
+	archiveMisses++;
+	using namespace std::chrono;
+	auto start = steady_clock::now();
+	PluginHolder<IndexedArchive> ai = MakePluginHolder<IndexedArchive>(IE_BIF_CLASS_ID);
+	if (ai->OpenArchive( biffiles[bifnum].path ) == GEM_ERROR) {
+		Log(ERROR, "KEYImporter", "Cannot open archive {}", biffiles[bifnum].path);
+		return NULL;
+	}
+	archiveOpenTime += duration_cast<microseconds>(steady_clock::now() - start).count();
+
+	// the returned streams are independent of the archive, so evicting is always safe
+	KEYCache* slot;
+	if (openArchives.size() < MaxOpenArchives) {
+		openArchives.emplace_back();
+		slot = &openArchives.back();
+	} else {
+		slot = &openArchives[0];
+		for (auto& cached : openArchives) {
+			if (cached.lastUsed < slot->lastUsed) {
+				slot = &cached;
+			}
+		}
+	}
+
+	slot->bifnum = bifnum;
+	slot->lastUsed = archiveUses;
+	slot->plugin = ai;
+	return ai.get();
+}
+
 DataStream* KEYImporter::GetResource(StringView resname, SClass_ID type)
 {
 	//the word masking is a hack for synonyms, currently used for bcs==bs
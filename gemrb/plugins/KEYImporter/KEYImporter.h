@@ -28,6 +28,7 @@
 #include "Resource.h"
 #include "StringMap.h"
 
+#include <mutex>
 #include <vector>
 
 namespace GemRB {
@@ -44,9 +45,10 @@ struct BIFEntry {
 };
 
 struct KEYCache {
-	KEYCache() { bifnum = 0xffffffff; }
+	KEYCache() { bifnum = 0xffffffff; lastUsed = 0; }
 
 	unsigned int bifnum;
+	unsigned long lastUsed;
 	PluginHolder<IndexedArchive> plugin;
 };
 
@@ -130,9 +132,28 @@ private:
 	std::vector< BIFEntry> biffiles;
 	KEYImpMap resources;
 
+	// already opened archives, so we don't have to reparse a BIF for every resource;
+	// the pool size is also the limit of file handles / mappings we keep around
+	static const size_t MaxOpenArchives = 16;
+	std::vector<KEYCache> openArchives;
+	unsigned long archiveUses = 0;
+	std::mutex archiveLock;
+
+	// pool statistics
+	unsigned long archiveHits = 0;
+	unsigned long archiveMisses = 0;
+	unsigned long archiveOpenTime = 0; // in microseconds
+
 	/** Gets the stream assoicated to a RESKey */
 	DataStream *GetStream(const ResRef&, ieWord type);
+	/** Returns an opened archive for the bif, reusing the pool if possible */
+	IndexedArchive* GetArchive(unsigned int bifnum);
 public:
+	KEYImporter() noexcept = default;
+	KEYImporter(const KEYImporter&) = delete;
+	~KEYImporter() override;
+	KEYImporter& operator=(const KEYImporter&) = delete;
+
 	bool Open(const char *file, const char *desc) override;
 	/* predicts the availability of a resource */
 	bool HasResource(StringView resname, SClass_ID type) override;
@@ -73,6 +73,9 @@ SDL20VideoDriver::~SDL20VideoDriver() noexcept
 	// we cant rely on the base destructor here
 	scratchBuffer = nullptr;
 	DestroyBuffers();
+	if (textureAtlas) {
+		textureAtlas->Clear();
+	}
 
 	SDL_DestroyRenderer(renderer);
 	SDL_DestroyWindow(window);
@@ -178,6 +181,14 @@ int SDL20VideoDriver::CreateSDLDisplay(const char* title)
 		return GEM_ERROR;
 	}
 
+#if SDL_VERSION_ATLEAST(2, 0, 18) && !USE_OPENGL_BACKEND
+	// our shader is set up per blit, so it can't batch
+	if (sdl2_runtime_version >= SDL_VERSIONNUM(2,0,18)) {
+		spriteBatch = GemRB::make_unique<SDLSpriteBatch>(renderer, frameStats);
+	}
+#endif
+	textureAtlas = std::make_shared<SDLTextureAtlas>(renderer, spriteBatch.get());
+
 #if USE_OPENGL_BACKEND
 	// glGetString can return null, fmt doesn't support const unsigned char* and std::string can handle neither
 	std::string tmp[4] = { "/" };
@@ -237,7 +248,18 @@ VideoBuffer* SDL20VideoDriver::NewVideoBuffer(const Region& r, BufferFormat fmt)
 		Log(ERROR, "SDL 2", "{}", SDL_GetError());
 		return nullptr;
 	}
-	return new SDLTextureVideoBuffer(r.origin, tex, fmt, renderer);
+	return new SDLTextureVideoBuffer(r.origin, tex, fmt, renderer, spriteBatch.get());
+}
+
+Holder<Sprite2D> SDL20VideoDriver::CreateSprite(const Region& rgn, void* pixels, const PixelFormat& fmt)
+{
+	Holder<Sprite2D> spr = SDLVideoDriver::CreateSprite(rgn, pixels, fmt);
+	// sprites made from resource data, like map tiles and animation frames, are hardly ever changed
+	// so the small ones are packed together, making it possible to batch their draws
+	if (pixels && textureAtlas && rgn.w <= SDLTextureAtlas::MAX_SPRITE_SIZE && rgn.h <= SDLTextureAtlas::MAX_SPRITE_SIZE) {
+		static_cast<sprite_t*>(spr.get())->UseAtlas(textureAtlas);
+	}
+	return spr;
 }
 
 void SDL20VideoDriver::SwapBuffers(VideoBuffers& buffers)
@@ -250,6 +272,14 @@ void SDL20VideoDriver::SwapBuffers(VideoBuffers& buffers)
 	blitRGBAShader->SetUniformValue("u_rgba", 1, 1);
 #endif
 
+	FlushSprites(true);
+	lastFrameStats = frameStats;
+	lastFrameStats.textures = SDLTextureSprite2D::LiveTextures() + buffers.size();
+	if (textureAtlas) {
+		lastFrameStats.textures += textureAtlas->PageCount();
+	}
+	frameStats = FrameStats();
+
 	SDL_SetRenderTarget(renderer, NULL);
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
 	SDL_RenderClear(renderer);
@@ -285,6 +315,9 @@ int SDL20VideoDriver::UpdateRenderTarget(const Color* color, BlitFlags flags)
 {
 	// TODO: add support for BlitFlags::HALFTRANS, BlitFlags::COLOR_MOD, and others (no use for them ATM)
 
+	// whatever is drawn next must end up above the batched sprites
+	FlushSprites();
+
 	SDL_Texture* target = CurrentRenderBuffer();
 
 	assert(target);
@@ -334,7 +367,59 @@ void SDL20VideoDriver::BlitSpriteNativeClipped(const SDLTextureSprite2D* spr, co
 	}
 
 	SDL_Texture* tex = spr->GetTexture(renderer);
-	BlitSpriteNativeClipped(tex, src, dst, flags, tint);
+	// the sprite may be packed into an atlas page
+	const Region texSrc(src.origin + spr->TextureOrigin(), src.size);
+	// only atlas pages are safe to batch, they flush the batch before they change or go away
+	if (spriteBatch && spr->InAtlas() && !(flags & BLIT_STENCIL_MASK)) {
+		BatchSprite(tex, texSrc, dst, flags, tint);
+	} else {
+		BlitSpriteNativeClipped(tex, texSrc, dst, flags, tint);
+	}
+}
+
+static SDL_BlendMode SpriteBlendMode(BlitFlags flags)
+{
+	if (flags & BlitFlags::ADD) {
+		return SDL_BLENDMODE_ADD;
+	} else if (flags & BlitFlags::MULTIPLY) {
+		return SDL_BLENDMODE_MOD;
+	} else if (flags & (BlitFlags::BLENDED | BlitFlags::HALFTRANS)) {
+		return SDL_BLENDMODE_BLEND;
+	}
+	return SDL_BLENDMODE_NONE;
+}
+
+void SDL20VideoDriver::BatchSprite(SDL_Texture* texture, const Region& src, const Region& dst, BlitFlags flags, const SDL_Color* tint)
+{
+	// the same modulation RenderCopyShaded applies to the texture
+	SDL_Color color = { 0xff, 0xff, 0xff, SDL_ALPHA_OPAQUE };
+	if (flags & BlitFlags::ALPHA_MOD) {
+		color.a = tint->a;
+	}
+	if (flags & BlitFlags::HALFTRANS) {
+		color.a /= 2;
+	}
+	if (flags & BlitFlags::COLOR_MOD) {
+		color.r = tint->r;
+		color.g = tint->g;
+		color.b = tint->b;
+	}
+
+	// like UpdateRenderTarget, no clip rect for the whole screen
+	const SDL_Rect* clip = nullptr;
+	if (screenClip.size != screenSize) {
+		clip = reinterpret_cast<const SDL_Rect*>(&screenClip);
+	}
+
+	spriteBatch->Add(texture, CurrentRenderBuffer(), clip, SpriteBlendMode(flags), RectFromRegion(src), RectFromRegion(dst),
+					 color, flags & BlitFlags::MIRRORX, flags & BlitFlags::MIRRORY);
+}
+
+void SDL20VideoDriver::FlushSprites(bool frameEnd)
+{
+	if (spriteBatch) {
+		spriteBatch->Flush(frameEnd);
+	}
 }
 
 void SDL20VideoDriver::BlitSpriteNativeClipped(SDL_Texture* texSprite, const Region& srgn, const Region& drgn, BlitFlags flags, const SDL_Color* tint)
@@ -342,6 +427,9 @@ void SDL20VideoDriver::BlitSpriteNativeClipped(SDL_Texture* texSprite, const Reg
 	SDL_Rect srect = RectFromRegion(srgn);
 	SDL_Rect drect = RectFromRegion(drgn);
 	
+	// the stencil path below switches render targets on its own
+	FlushSprites();
+
 	int ret = 0;
 #if USE_OPENGL_BACKEND
 	UpdateRenderTarget();
@@ -366,6 +454,7 @@ void SDL20VideoDriver::BlitSpriteNativeClipped(SDL_Texture* texSprite, const Reg
 		stencilRect.x -= stencilBuffer->Origin().x;
 		stencilRect.y -= stencilBuffer->Origin().y;
 		SDL_RenderCopy(renderer, stencilTex, &stencilRect, &drect);
+		frameStats.drawCalls++;
 
 		if (flags & (BlitFlags::ALPHA_MOD | BlitFlags::HALFTRANS)) {
 			Uint8 alpha = SDL_ALPHA_OPAQUE;
@@ -381,6 +470,7 @@ void SDL20VideoDriver::BlitSpriteNativeClipped(SDL_Texture* texSprite, const Reg
 		SDL_SetRenderTarget(renderer, CurrentRenderBuffer());
 		SDL_SetTextureBlendMode(ScratchBuffer(), SDL_BLENDMODE_BLEND);
 		ret = SDL_RenderCopy(renderer, ScratchBuffer(), &drect, &drect);
+		frameStats.drawCalls++;
 	} else {
 		UpdateRenderTarget();
 		ret = RenderCopyShaded(texSprite, &srect, &drect, flags, tint);
@@ -518,19 +608,12 @@ int SDL20VideoDriver::RenderCopyShaded(SDL_Texture* texture, const SDL_Rect* src
 		SDL_SetTextureColorMod(texture, 0xff, 0xff, 0xff);
 	}
 	
-	if (flags & BlitFlags::ADD) {
-		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_ADD);
-	} else if (flags & BlitFlags::MULTIPLY) {
-		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_MOD);
-	} else if (flags & (BlitFlags::BLENDED | BlitFlags::HALFTRANS)) {
-		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-	} else {
-		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
-	}
+	SDL_SetTextureBlendMode(texture, SpriteBlendMode(flags));
 
 	SDL_RendererFlip flipflags = (flags & BlitFlags::MIRRORY) ? SDL_FLIP_VERTICAL : SDL_FLIP_NONE;
 	flipflags = static_cast<SDL_RendererFlip>(flipflags | ((flags & BlitFlags::MIRRORX) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE));
 
+	frameStats.drawCalls++;
 	return SDL_RenderCopyEx(renderer, texture, srcrect, dstrect, 0.0, nullptr, flipflags);
 }
 
@@ -540,6 +623,9 @@ void SDL20VideoDriver::DrawRawGeometry(
 	BlitFlags blitFlags
 ) {
 #if SDL_VERSION_ATLEAST(2, 0, 18)
+	FlushSprites();
+	frameStats.drawCalls++;
+
 	if (blitFlags & BlitFlags::BLENDED) {
 		SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 	}
@@ -577,12 +663,14 @@ void SDL20VideoDriver::DrawSDLPoints(const std::vector<SDL_Point>& points, const
 	}
 	UpdateRenderTarget(reinterpret_cast<const Color*>(&color), flags);
 	SDL_RenderDrawPoints(renderer, &points[0], int(points.size()));
+	frameStats.drawCalls++;
 }
 
 void SDL20VideoDriver::DrawPointImp(const Point& p, const Color& color, BlitFlags flags)
 {
 	UpdateRenderTarget(&color, flags);
 	SDL_RenderDrawPoint(renderer, p.x, p.y);
+	frameStats.drawCalls++;
 }
 
 void SDL20VideoDriver::DrawLinesImp(const std::vector<Point>& points, const Color& color, BlitFlags flags)
@@ -594,12 +682,14 @@ void SDL20VideoDriver::DrawSDLLines(const std::vector<SDL_Point>& points, const
 {
 	UpdateRenderTarget(reinterpret_cast<const Color*>(&color), flags);
 	SDL_RenderDrawLines(renderer, &points[0], int(points.size()));
+	frameStats.drawCalls++;
 }
 
 void SDL20VideoDriver::DrawLineImp(const Point& p1, const Point& p2, const Color& color, BlitFlags flags)
 {
 	UpdateRenderTarget(&color, flags);
 	SDL_RenderDrawLine(renderer, p1.x, p1.y, p2.x, p2.y);
+	frameStats.drawCalls++;
 }
 
 void SDL20VideoDriver::DrawRectImp(const Region& rgn, const Color& color, bool fill, BlitFlags flags)
@@ -610,6 +700,7 @@ void SDL20VideoDriver::DrawRectImp(const Region& rgn, const Color& color, bool f
 	} else {
 		SDL_RenderDrawRect(renderer, reinterpret_cast<const SDL_Rect*>(&rgn));
 	}
+	frameStats.drawCalls++;
 }
 
 void SDL20VideoDriver::DrawPolygonImp(const Gem_Polygon* poly, const Point& origin, const Color& color, bool fill, BlitFlags flags)
@@ -626,6 +717,7 @@ void SDL20VideoDriver::DrawPolygonImp(const Gem_Polygon* poly, const Point& orig
 				Point p1(segment.first + origin);
 				Point p2(segment.second + origin);
 				SDL_RenderDrawLine(renderer, p1.x, p1.y, p2.x, p2.y);
+				frameStats.drawCalls++;
 			}
 		}
 	} else {
@@ -654,6 +746,7 @@ Holder<Sprite2D> SDL20VideoDriver::GetScreenshot(Region r, const VideoBufferPtr&
 	static const PixelFormat fmt(3, 0x00ff0000, 0x0000ff00, 0x000000ff, 0);
 	SDLTextureSprite2D* screenshot = new SDLTextureSprite2D(Region(0,0, Width, Height), fmt);
 
+	FlushSprites();
 	SDL_Texture* target = SDL_GetRenderTarget(renderer);
 	if (buf) {
 		auto texture = static_cast<SDLTextureVideoBuffer*>(buf.get())->GetTexture();
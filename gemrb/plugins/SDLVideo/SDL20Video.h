@@ -22,7 +22,11 @@
 #define SDL20VideoDRIVER_H
 
 #include "SDLVideo.h"
+#include "SDLSpriteBatch.h"
 #include "SDLSurfaceSprite2D.h"
+#include "SDLTextureAtlas.h"
+
+#include <memory>
 
 #if USE_OPENGL_BACKEND
 #include "GLSLProgram.h"
@@ -76,6 +80,9 @@ class SDLTextureVideoBuffer : public VideoBuffer {
 	// this is also used for rendering stencils
 	SDL_Surface* conversionBuffer = nullptr;
 
+	// sprites batched for this buffer have to be drawn before it changes
+	SDLSpriteBatch* batch;
+
 private:
 	static Region TextureRegion(SDL_Texture* tex, const Point& p) {
 		int w, h;
@@ -84,8 +91,8 @@ private:
 	}
 
 public:
-	SDLTextureVideoBuffer(const Point& p, SDL_Texture* texture, Video::BufferFormat fmt, SDL_Renderer* renderer)
-	: VideoBuffer(TextureRegion(texture, p)), texture(texture), renderer(renderer), inputFormat(SDLPixelFormatFromBufferFormat(fmt, NULL))
+	SDLTextureVideoBuffer(const Point& p, SDL_Texture* texture, Video::BufferFormat fmt, SDL_Renderer* renderer, SDLSpriteBatch* batch = nullptr)
+	: VideoBuffer(TextureRegion(texture, p)), texture(texture), renderer(renderer), inputFormat(SDLPixelFormatFromBufferFormat(fmt, NULL)), batch(batch)
 	{
 		assert(texture);
 		assert(renderer);
@@ -101,11 +108,13 @@ public:
 	}
 
 	~SDLTextureVideoBuffer() override {
+		if (batch) batch->Flush();
 		SDL_DestroyTexture(texture);
 		SDL_FreeSurface(conversionBuffer);
 	}
 
 	void Clear() override {
+		if (batch) batch->Flush();
 		SDL_SetRenderTarget(renderer, texture);
 		SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
 #if SDL_COMPILEDVERSION == SDL_VERSIONNUM(2, 0, 10)
@@ -120,6 +129,7 @@ public:
 	}
 	
 	void Clear(const SDL_Rect& rgn) {
+		if (batch) batch->Flush();
 		SDL_SetRenderTarget(renderer, texture);
 		SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
 		SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
@@ -142,6 +152,7 @@ public:
 	}
 
 	void CopyPixels(const Region& bufDest, const void* pixelBuf, const int* pitch = NULL, ...) override {
+		if (batch) batch->Flush();
 		int sdlpitch = bufDest.w * SDL_BYTESPERPIXEL(nativeFormat);
 		SDL_Rect dest = RectFromRegion(bufDest);
 
@@ -219,6 +230,13 @@ private:
 	SDL_GameController* gameController = nullptr;
 
 	GLSLProgram* blitRGBAShader = nullptr;
+
+	// only when SDL_RenderGeometry is available and we don't use our own shader
+	std::unique_ptr<SDLSpriteBatch> spriteBatch;
+	// shared with the sprites packed into it, which may outlive us
+	std::shared_ptr<SDLTextureAtlas> textureAtlas;
+	FrameStats frameStats;
+	FrameStats lastFrameStats;
 public:
 	SDL20VideoDriver() noexcept;
 	~SDL20VideoDriver() noexcept override;
@@ -239,6 +257,10 @@ public:
 	
 	bool TouchInputEnabled() override;
 	bool CanDrawRawGeometry() const override;
+	bool CanCopyVideoBuffers() const override { return true; }
+	FrameStats GetFrameStats() const override { return lastFrameStats; }
+
+	Holder<Sprite2D> CreateSprite(const Region&, void* pixels, const PixelFormat&) override;
 
 	void BlitVideoBuffer(const VideoBufferPtr& buf, const Point& p, BlitFlags flags,
 						 Color tint = Color()) override;
@@ -279,6 +301,8 @@ private:
 	void BlitSpriteNativeClipped(SDL_Texture* spr, const Region& src, const Region& dst, BlitFlags flags = BlitFlags::NONE, const SDL_Color* tint = NULL);
 
 	int RenderCopyShaded(SDL_Texture*, const SDL_Rect* srcrect, const SDL_Rect* dstrect, BlitFlags flags, const SDL_Color* = nullptr);
+	void BatchSprite(SDL_Texture*, const Region& src, const Region& dst, BlitFlags flags, const SDL_Color* tint);
+	void FlushSprites(bool frameEnd = false);
 
 	int GetTouchFingers(TouchEvent::Finger(&fingers)[FINGER_MAX], SDL_TouchID device) const;
 };
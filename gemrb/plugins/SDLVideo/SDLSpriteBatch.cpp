@@ -0,0 +1,125 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "SDLSpriteBatch.h"
+
+#include "Logging/Logging.h"
+
+#include <utility>
+
+namespace GemRB {
+
+// past this the batch is drawn even if nothing changed
+static constexpr size_t MAX_BATCH_SPRITES = 4096;
+
+SDLSpriteBatch::SDLSpriteBatch(SDL_Renderer* renderer, Video::FrameStats& stats)
+: renderer(renderer), stats(stats)
+{
+	xy.reserve(MAX_BATCH_SPRITES * 8);
+	uv.reserve(MAX_BATCH_SPRITES * 8);
+	colors.reserve(MAX_BATCH_SPRITES * 4);
+	indices.reserve(MAX_BATCH_SPRITES * 6);
+}
+
+void SDLSpriteBatch::Add(SDL_Texture* tex, SDL_Texture* renderTarget, const SDL_Rect* clipRect, SDL_BlendMode blend,
+						 const SDL_Rect& src, const SDL_Rect& dst, const SDL_Color& color, bool mirrorX, bool mirrorY)
+{
+	if (!Empty()) {
+		bool sameClip = clipRect ? clipped && SDL_RectEquals(clipRect, &clip) : !clipped;
+		if (tex != texture || renderTarget != target || blend != blendMode || !sameClip) {
+			Flush();
+		} else if (indices.size() >= MAX_BATCH_SPRITES * 6) {
+			Draw();
+		}
+	}
+
+	if (Empty()) {
+		int w = 1;
+		int h = 1;
+		SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
+		texW = float(w);
+		texH = float(h);
+		texture = tex;
+		target = renderTarget;
+		blendMode = blend;
+		clipped = clipRect != nullptr;
+		if (clipped) {
+			clip = *clipRect;
+		}
+	}
+
+	float x1 = float(dst.x);
+	float y1 = float(dst.y);
+	float x2 = float(dst.x + dst.w);
+	float y2 = float(dst.y + dst.h);
+	float u1 = src.x / texW;
+	float v1 = src.y / texH;
+	float u2 = (src.x + src.w) / texW;
+	float v2 = (src.y + src.h) / texH;
+	// like SDL_RenderCopyEx, mirroring flips the source inside the destination
+	if (mirrorX) std::swap(u1, u2);
+	if (mirrorY) std::swap(v1, v2);
+
+	int first = int(colors.size());
+	xy.insert(xy.end(), { x1, y1, x2, y1, x2, y2, x1, y2 });
+	uv.insert(uv.end(), { u1, v1, u2, v1, u2, v2, u1, v2 });
+	colors.insert(colors.end(), 4, color);
+	indices.insert(indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+}
+
+void SDLSpriteBatch::Draw()
+{
+	SDL_SetRenderTarget(renderer, target);
+	SDL_RenderSetClipRect(renderer, clipped ? &clip : nullptr);
+	// the modulation is in the vertex colors
+	SDL_SetTextureColorMod(texture, 0xff, 0xff, 0xff);
+	SDL_SetTextureAlphaMod(texture, SDL_ALPHA_OPAQUE);
+	SDL_SetTextureBlendMode(texture, blendMode);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	int ret = SDL_RenderGeometryRaw(renderer, texture,
+									xy.data(), 2 * sizeof(float),
+									colors.data(), sizeof(SDL_Color),
+									uv.data(), 2 * sizeof(float),
+									int(colors.size()),
+									indices.data(), int(indices.size()), sizeof(int));
+	if (ret != 0) {
+		Log(ERROR, "SDLSpriteBatch", "{}", SDL_GetError());
+	}
+#endif
+	stats.drawCalls++;
+
+	xy.clear();
+	uv.clear();
+	colors.clear();
+	indices.clear();
+}
+
+void SDLSpriteBatch::Flush(bool frameEnd)
+{
+	if (Empty()) return;
+
+	if (!frameEnd) {
+		stats.batchBreaks++;
+	}
+	Draw();
+}
+
+}
@@ -0,0 +1,73 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SDLSPRITEBATCH_H
+#define SDLSPRITEBATCH_H
+
+#include "Video/Video.h"
+
+#include <SDL.h>
+
+#include <vector>
+
+namespace GemRB {
+
+// Collects sprite blits that share a texture, render target, blend mode and
+// clip rect and draws them with a single SDL_RenderGeometryRaw call.
+// The color and alpha modulation go into the vertex colors, so they may differ
+// between the sprites of a batch.
+// Anything else that draws must Flush() first to keep the drawing order.
+class SDLSpriteBatch {
+	SDL_Renderer* renderer;
+	Video::FrameStats& stats;
+
+	SDL_Texture* texture = nullptr;
+	SDL_Texture* target = nullptr;
+	SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+	SDL_Rect clip {};
+	bool clipped = false;
+	float texW = 1.0f;
+	float texH = 1.0f;
+
+	std::vector<float> xy;
+	std::vector<float> uv;
+	std::vector<SDL_Color> colors;
+	std::vector<int> indices;
+
+	void Draw();
+
+public:
+	SDLSpriteBatch(SDL_Renderer* renderer, Video::FrameStats& stats);
+	SDLSpriteBatch(const SDLSpriteBatch&) = delete;
+	SDLSpriteBatch& operator=(const SDLSpriteBatch&) = delete;
+
+	bool Empty() const { return indices.empty(); }
+
+	// clip is null when the whole target is drawable
+	void Add(SDL_Texture* tex, SDL_Texture* renderTarget, const SDL_Rect* clipRect, SDL_BlendMode blend,
+			 const SDL_Rect& src, const SDL_Rect& dst, const SDL_Color& color, bool mirrorX, bool mirrorY);
+	// draws what was collected so far, counted as a batch break
+	// unless it happens at the end of a frame
+	void Flush(bool frameEnd = false);
+};
+
+}
+
+#endif
@@ -290,14 +290,17 @@ SDLTextureSprite2D::SDLTextureSprite2D(const Region& rgn, const PixelFormat& fmt
 : SDLSurfaceSprite2D(rgn, fmt)
 {}
 
+size_t SDLTextureSprite2D::liveTextures = 0;
+
 SDLTextureSprite2D::~SDLTextureSprite2D() noexcept
 {
-	SDL_DestroyTexture(texture);
+	for (TextureVersion& tex : textures) {
+		FreeVersion(tex);
+	}
 }
 
 SDLTextureSprite2D::SDLTextureSprite2D(const SDLTextureSprite2D& other) noexcept
-	: SDLSurfaceSprite2D(other), texFormat(other.texFormat), texture(nullptr),
-	staleTexture(false)
+	: SDLSurfaceSprite2D(other), staleTexture(false), atlas(other.atlas)
 {}
 
 Holder<Sprite2D> SDLTextureSprite2D::copy() const
@@ -305,24 +308,162 @@ Holder<Sprite2D> SDLTextureSprite2D::copy() const
 	return Holder<Sprite2D>(new SDLTextureSprite2D(*this));
 }
 
-SDL_Texture* SDLTextureSprite2D::GetTexture(SDL_Renderer* renderer) const
+void SDLTextureSprite2D::UnlockSprite() const
+{
+	SDLSurfaceSprite2D::UnlockSprite();
+	// the pixels changed, so none of the versions are any good
+	// keep the textures and slots around for the next uploads
+	for (TextureVersion& tex : textures) {
+		tex.valid = false;
+	}
+}
+
+bool SDLTextureSprite2D::ConvertFormatTo(const PixelFormat& tofmt) noexcept
+{
+	if (!SDLSurfaceSprite2D::ConvertFormatTo(tofmt)) {
+		return false;
+	}
+	for (TextureVersion& tex : textures) {
+		tex.valid = false;
+	}
+	Invalidate();
+	return true;
+}
+
+void SDLTextureSprite2D::UseAtlas(std::shared_ptr<SDLTextureAtlas> textureAtlas)
+{
+	assert(textures.empty());
+	atlas = std::move(textureAtlas);
+}
+
+uint64_t SDLTextureSprite2D::VersionKey() const noexcept
+{
+	SDL_Surface* rendered = GetSurface();
+	const SDL_Palette* pal = rendered->format->palette;
+	if (pal == nullptr) {
+		// the flags are all there is to a version of a true color sprite
+		return version;
+	}
+
+	// the palette is copied around (and modified in place for tints and effects),
+	// so identify the version by the resulting colors instead
+	// FNV-1a, a collision would only draw the sprite with the wrong colors
+	uint64_t key = 0xcbf29ce484222325ULL;
+	auto mix = [&key](uint32_t value) {
+		for (int i = 0; i < 4; ++i) {
+			key ^= (value >> (i * 8)) & 0xff;
+			key *= 0x100000001b3ULL;
+		}
+	};
+	for (int i = 0; i < pal->ncolors; ++i) {
+		const SDL_Color& c = pal->colors[i];
+		mix(uint32_t(c.r) | uint32_t(c.g) << 8 | uint32_t(c.b) << 16 | uint32_t(c.a) << 24);
+	}
+	Uint32 colorKey = 0;
+	mix(SDL_GetColorKey(rendered, &colorKey) == 0 ? colorKey : 0xffffffff);
+	return key;
+}
+
+void SDLTextureSprite2D::UploadVersion(SDL_Renderer* renderer, TextureVersion& tex) const
+{
+	SDL_Surface* rendered = GetSurface();
+
+	if (atlas && tex.texture == nullptr) {
+		if (!tex.atlasSlot) {
+			tex.atlasSlot = atlas->Allocate(Frame.size);
+		}
+		// a full atlas leaves us with our own texture
+		if (tex.atlasSlot) {
+			atlas->Upload(tex.atlasSlot, rendered);
+			tex.valid = true;
+			return;
+		}
+	}
+
+	if (tex.texture == nullptr) {
+		tex.texture = SDL_CreateTextureFromSurface(renderer, rendered);
+		SDL_QueryTexture(tex.texture, &tex.texFormat, nullptr, nullptr, nullptr);
+		liveTextures++;
+	} else if (tex.texFormat == rendered->format->format) {
+		SDL_UpdateTexture(tex.texture, nullptr, rendered->pixels, rendered->pitch);
+	} else {
+		SDL_Surface *temp = SDL_ConvertSurfaceFormat(rendered, tex.texFormat, 0);
+		assert(temp);
+		SDL_UpdateTexture(tex.texture, nullptr, temp->pixels, temp->pitch);
+		SDL_FreeSurface(temp);
+	}
+	tex.valid = true;
+}
+
+void SDLTextureSprite2D::FreeVersion(TextureVersion& tex) const
 {
-	if (texture == nullptr) {
-		texture = SDL_CreateTextureFromSurface(renderer, GetSurface());
-		SDL_QueryTexture(texture, &texFormat, nullptr, nullptr, nullptr);
-	} else if (staleTexture) {
-		SDL_Surface *surface = GetSurface();
-		if (texFormat == surface->format->format) {
-			SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch);
+	if (tex.texture) {
+		SDL_DestroyTexture(tex.texture);
+		tex.texture = nullptr;
+		liveTextures--;
+	}
+	if (atlas) {
+		atlas->Release(tex.atlasSlot);
+	}
+	tex.valid = false;
+}
+
+void SDLTextureSprite2D::SelectVersion(SDL_Renderer* renderer) const
+{
+	uint64_t key = VersionKey();
+	++useCount;
+
+	for (size_t i = 0; i < textures.size(); ++i) {
+		TextureVersion& tex = textures[i];
+		if (tex.valid && tex.key == key) {
+			// already uploaded, nothing to send to the GPU
+			tex.lastUse = useCount;
+			current = i;
+			return;
+		}
+	}
+
+	// prefer a version that went stale, then a new one, then the least recently used
+	size_t pick = textures.size();
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (!textures[i].valid) {
+			pick = i;
+			break;
+		}
+	}
+	if (pick == textures.size()) {
+		if (textures.size() < MAX_TEXTURE_VERSIONS) {
+			textures.emplace_back();
 		} else {
-			SDL_Surface *temp = SDL_ConvertSurfaceFormat(surface, texFormat, 0);
-			assert(temp);
-			SDL_UpdateTexture(texture, nullptr, temp->pixels, temp->pitch);
-			SDL_FreeSurface(temp);
+			pick = 0;
+			for (size_t i = 1; i < textures.size(); ++i) {
+				if (textures[i].lastUse < textures[pick].lastUse) {
+					pick = i;
+				}
+			}
 		}
+	}
+
+	TextureVersion& tex = textures[pick];
+	// the storage is reused, so only the pixels go over to the GPU
+	UploadVersion(renderer, tex);
+	tex.key = key;
+	tex.lastUse = useCount;
+	current = pick;
+}
+
+SDL_Texture* SDLTextureSprite2D::GetTexture(SDL_Renderer* renderer) const
+{
+	if (staleTexture || textures.empty() || !textures[current].valid) {
+		SelectVersion(renderer);
 		staleTexture = false;
 	}
-	return texture;
+
+	const TextureVersion& tex = textures[current];
+	if (tex.atlasSlot) {
+		return atlas->Texture(tex.atlasSlot);
+	}
+	return tex.texture;
 }
 
 void SDLTextureSprite2D::Invalidate() const noexcept
@@ -26,6 +26,13 @@
 
 #include <SDL.h>
 
+#if SDL_VERSION_ATLEAST(1,3,0)
+#include "SDLTextureAtlas.h"
+
+#include <memory>
+#include <vector>
+#endif
+
 namespace GemRB {
 
 class SDLSurfaceSprite2D : public Sprite2D {
@@ -78,11 +85,33 @@ public:
 // it would probably be better to not inherit from SDLSurfaceSprite2D
 // the hard part is handling the palettes ourselves
 class SDLTextureSprite2D : public SDLSurfaceSprite2D {
-	mutable Uint32 texFormat = SDL_PIXELFORMAT_UNKNOWN;
-	mutable SDL_Texture* texture = nullptr;
+	// the texture of one rendered version of the sprite
+	// the same frame is often drawn with a few palettes or tints in turn,
+	// so we keep some of them around instead of uploading the pixels every time
+	struct TextureVersion {
+		uint64_t key = 0; // see VersionKey
+		bool valid = false;
+		unsigned int lastUse = 0;
+		Uint32 texFormat = SDL_PIXELFORMAT_UNKNOWN;
+		SDL_Texture* texture = nullptr; // unless it is in the atlas
+		SDLTextureAtlas::Slot atlasSlot;
+	};
+	static constexpr size_t MAX_TEXTURE_VERSIONS = 4;
+
+	mutable std::vector<TextureVersion> textures;
+	mutable size_t current = 0;
+	mutable unsigned int useCount = 0;
 	mutable bool staleTexture = false;
+	// when set, the sprite is packed into an atlas page instead of getting its own texture
+	std::shared_ptr<SDLTextureAtlas> atlas;
+
+	static size_t liveTextures;
 	
 	void Invalidate() const noexcept override;
+	uint64_t VersionKey() const noexcept;
+	void SelectVersion(SDL_Renderer* renderer) const;
+	void UploadVersion(SDL_Renderer* renderer, TextureVersion& tex) const;
+	void FreeVersion(TextureVersion& tex) const;
 public:
 	SDLTextureSprite2D(const SDLTextureSprite2D&) noexcept;
 	SDLTextureSprite2D(const Region&, void* pixels, const PixelFormat& fmt) noexcept;
@@ -90,8 +119,19 @@ public:
 	~SDLTextureSprite2D() noexcept;
 	
 	Holder<Sprite2D> copy() const override;
-	
+
+	void UnlockSprite() const override;
+	bool ConvertFormatTo(const PixelFormat& tofmt) noexcept override;
+
+	void UseAtlas(std::shared_ptr<SDLTextureAtlas> textureAtlas);
+	// either the sprite's own texture or an atlas page, for the current palette and flags
 	SDL_Texture* GetTexture(SDL_Renderer* renderer) const;
+	bool InAtlas() const { return !textures.empty() && textures[current].atlasSlot; }
+	// where the sprite pixels are in the GetTexture texture
+	Point TextureOrigin() const { return InAtlas() ? textures[current].atlasSlot.rgn.origin : Point(); }
+
+	// the number of textures the sprites own, atlas pages not included
+	static size_t LiveTextures() { return liveTextures; }
 };
 #endif
 
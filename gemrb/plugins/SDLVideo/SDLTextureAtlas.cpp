@@ -0,0 +1,235 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "SDLTextureAtlas.h"
+
+#include "SDLSpriteBatch.h"
+
+#include "Logging/Logging.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace GemRB {
+
+static constexpr Uint32 PAGE_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+static constexpr int MAX_PAGE_SIZE = 2048;
+static constexpr size_t MAX_PAGES = 16;
+// a transparent border around every sprite, so filtering doesn't pick up the neighbours
+// or whatever a shelf still holds from earlier sprites
+static constexpr int PADDING = 1;
+// shelf heights are rounded up to this, so similar sprites share shelves
+static constexpr int SHELF_STEP = 8;
+
+SDLTextureAtlas::SDLTextureAtlas(SDL_Renderer* renderer, SDLSpriteBatch* batch)
+: renderer(renderer), batch(batch), pageSize(MAX_PAGE_SIZE)
+{
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(renderer, &info) == 0) {
+		if (info.max_texture_width) pageSize = std::min(pageSize, info.max_texture_width);
+		if (info.max_texture_height) pageSize = std::min(pageSize, info.max_texture_height);
+	}
+}
+
+SDLTextureAtlas::~SDLTextureAtlas()
+{
+	Clear();
+}
+
+bool SDLTextureAtlas::AllocateInPage(Page& page, const Size& padded, Point& pos) const
+{
+	int shelfHeight = (padded.h + SHELF_STEP - 1) / SHELF_STEP * SHELF_STEP;
+
+	for (Shelf& shelf : page.shelves) {
+		if (shelf.h != shelfHeight) continue;
+
+		for (auto span = shelf.freeSpans.begin(); span != shelf.freeSpans.end(); ++span) {
+			if (span->w < padded.w) continue;
+
+			pos = Point(span->x, shelf.y);
+			span->x += padded.w;
+			span->w -= padded.w;
+			if (span->w == 0) {
+				shelf.freeSpans.erase(span);
+			}
+			return true;
+		}
+
+		if (shelf.end + padded.w <= pageSize) {
+			pos = Point(shelf.end, shelf.y);
+			shelf.end += padded.w;
+			return true;
+		}
+	}
+
+	if (page.shelvesEnd + shelfHeight > pageSize) {
+		return false;
+	}
+
+	Shelf shelf;
+	shelf.y = page.shelvesEnd;
+	shelf.h = shelfHeight;
+	shelf.end = padded.w;
+	page.shelves.push_back(std::move(shelf));
+	page.shelvesEnd += shelfHeight;
+	pos = Point(0, page.shelves.back().y);
+	return true;
+}
+
+SDLTextureAtlas::Slot SDLTextureAtlas::Allocate(const Size& size)
+{
+	Slot slot;
+	if (size.IsInvalid() || size.w > MAX_SPRITE_SIZE || size.h > MAX_SPRITE_SIZE) {
+		return slot;
+	}
+
+	Size padded(size.w + 2 * PADDING, size.h + 2 * PADDING);
+	Point pos;
+	for (size_t i = 0; i <= pages.size(); ++i) {
+		if (i == pages.size()) {
+			if (pages.size() == MAX_PAGES) break;
+			pages.emplace_back();
+		}
+
+		Page& page = pages[i];
+		if (!AllocateInPage(page, padded, pos)) continue;
+
+		if (page.texture == nullptr) {
+			page.texture = SDL_CreateTexture(renderer, PAGE_FORMAT, SDL_TEXTUREACCESS_STATIC, pageSize, pageSize);
+			if (page.texture == nullptr) {
+				Log(ERROR, "SDLTextureAtlas", "{}", SDL_GetError());
+				page = Page();
+				break;
+			}
+		}
+
+		page.sprites++;
+		slot.page = int(i);
+		slot.rgn = Region(pos + Point(PADDING, PADDING), size);
+		break;
+	}
+	return slot;
+}
+
+void SDLTextureAtlas::Release(Slot& slot)
+{
+	if (!slot || size_t(slot.page) >= pages.size()) {
+		slot = Slot();
+		return;
+	}
+
+	Page& page = pages[slot.page];
+	if (--page.sprites == 0) {
+		// the batch may still draw from the page
+		if (batch) batch->Flush();
+		SDL_DestroyTexture(page.texture);
+		page = Page();
+		slot = Slot();
+		return;
+	}
+
+	auto shelf = std::find_if(page.shelves.begin(), page.shelves.end(), [&slot](const Shelf& s) {
+		return s.y == slot.rgn.y - PADDING;
+	});
+	assert(shelf != page.shelves.end());
+
+	Span freed { slot.rgn.x - PADDING, slot.rgn.w + 2 * PADDING };
+	auto& spans = shelf->freeSpans;
+	auto next = std::lower_bound(spans.begin(), spans.end(), freed, [](const Span& a, const Span& b) {
+		return a.x < b.x;
+	});
+	next = spans.insert(next, freed);
+	// merge with the following and the preceding span
+	if (next + 1 != spans.end() && next->x + next->w == (next + 1)->x) {
+		next->w += (next + 1)->w;
+		spans.erase(next + 1);
+	}
+	if (next != spans.begin() && (next - 1)->x + (next - 1)->w == next->x) {
+		(next - 1)->w += next->w;
+		next = spans.erase(next) - 1;
+	}
+	// give a span at the end back to the shelf
+	if (next->x + next->w == shelf->end) {
+		shelf->end = next->x;
+		spans.erase(next);
+	}
+
+	slot = Slot();
+}
+
+void SDLTextureAtlas::Upload(const Slot& slot, SDL_Surface* surface)
+{
+	assert(slot && size_t(slot.page) < pages.size());
+
+	// sprites already in the batch must be drawn with the old pixels
+	if (batch) batch->Flush();
+
+	SDL_Texture* texture = pages[slot.page].texture;
+	const Region& r = slot.rgn;
+	SDL_Surface* converted = nullptr;
+	if (surface->format->format != PAGE_FORMAT) {
+		// this turns the color key into transparency, like SDL_CreateTextureFromSurface
+		converted = SDL_ConvertSurfaceFormat(surface, PAGE_FORMAT, 0);
+		if (converted == nullptr) {
+			Log(ERROR, "SDLTextureAtlas", "{}", SDL_GetError());
+			return;
+		}
+		surface = converted;
+	}
+
+	SDL_Rect dst = { r.x, r.y, r.w, r.h };
+	SDL_UpdateTexture(texture, &dst, surface->pixels, surface->pitch);
+	SDL_FreeSurface(converted);
+
+	static const std::vector<Uint32> transparent((MAX_SPRITE_SIZE + 2 * PADDING) * PADDING, 0);
+	int paddedW = r.w + 2 * PADDING;
+	SDL_Rect top = { r.x - PADDING, r.y - PADDING, paddedW, PADDING };
+	SDL_UpdateTexture(texture, &top, transparent.data(), paddedW * sizeof(Uint32));
+	SDL_Rect bottom = { r.x - PADDING, r.y + r.h, paddedW, PADDING };
+	SDL_UpdateTexture(texture, &bottom, transparent.data(), paddedW * sizeof(Uint32));
+	SDL_Rect left = { r.x - PADDING, r.y, PADDING, r.h };
+	SDL_UpdateTexture(texture, &left, transparent.data(), PADDING * sizeof(Uint32));
+	SDL_Rect right = { r.x + r.w, r.y, PADDING, r.h };
+	SDL_UpdateTexture(texture, &right, transparent.data(), PADDING * sizeof(Uint32));
+}
+
+SDL_Texture* SDLTextureAtlas::Texture(const Slot& slot) const
+{
+	assert(slot && size_t(slot.page) < pages.size());
+	return pages[slot.page].texture;
+}
+
+size_t SDLTextureAtlas::PageCount() const
+{
+	return std::count_if(pages.begin(), pages.end(), [](const Page& page) {
+		return page.texture != nullptr;
+	});
+}
+
+void SDLTextureAtlas::Clear()
+{
+	for (const Page& page : pages) {
+		SDL_DestroyTexture(page.texture);
+	}
+	pages.clear();
+	batch = nullptr;
+}
+
+}
@@ -0,0 +1,98 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2023 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SDLTEXTUREATLAS_H
+#define SDLTEXTUREATLAS_H
+
+#include "Region.h"
+
+#include <SDL.h>
+
+#include <vector>
+
+namespace GemRB {
+
+class SDLSpriteBatch;
+
+// Packs small sprites into a few big textures, so that the draws of map tiles
+// and animation frames can share a texture and be batched.
+// Every page is split into shelves (rows) of a rounded up height, and a shelf
+// hands out spans left to right. Released spans are reused by sprites that fit
+// the shelf, and a page is destroyed once it holds no sprites.
+class SDLTextureAtlas {
+public:
+	// sprites bigger than this in either dimension keep their own texture
+	static constexpr int MAX_SPRITE_SIZE = 256;
+
+	struct Slot {
+		int page = -1;
+		Region rgn; // where the pixels are, the padding is outside of it
+
+		explicit operator bool() const { return page >= 0; }
+	};
+
+private:
+	struct Span {
+		int x;
+		int w;
+	};
+
+	struct Shelf {
+		int y;
+		int h;
+		int end = 0; // everything right of this is free
+		std::vector<Span> freeSpans;
+	};
+
+	struct Page {
+		SDL_Texture* texture = nullptr;
+		std::vector<Shelf> shelves;
+		int shelvesEnd = 0; // everything below this is free
+		size_t sprites = 0;
+	};
+
+	SDL_Renderer* renderer;
+	SDLSpriteBatch* batch;
+	int pageSize;
+	std::vector<Page> pages;
+
+	bool AllocateInPage(Page& page, const Size& padded, Point& pos) const;
+
+public:
+	SDLTextureAtlas(SDL_Renderer* renderer, SDLSpriteBatch* batch);
+	SDLTextureAtlas(const SDLTextureAtlas&) = delete;
+	~SDLTextureAtlas();
+	SDLTextureAtlas& operator=(const SDLTextureAtlas&) = delete;
+
+	// an empty slot if the sprite doesn't fit anywhere
+	Slot Allocate(const Size& size);
+	void Release(Slot& slot);
+	// copies the surface pixels into the slot, converting them to the page format
+	void Upload(const Slot& slot, SDL_Surface* surface);
+	SDL_Texture* Texture(const Slot& slot) const;
+
+	size_t PageCount() const;
+	// destroys all the pages, existing slots become invalid
+	void Clear();
+};
+
+}
+
+#endif